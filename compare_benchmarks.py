@@ -0,0 +1,48 @@
+#!/usr/bin/python3
+# Compares two JSON outputs of maxmatching_bench (--benchmark_out=<file> --benchmark_out_format=json) and reports
+# benchmarks that got slower or faster by more than the threshold. With --benchmark_repetitions, the median of the
+# repetitions is compared, which keeps the comparison stable enough for differences of a few percent.
+import argparse
+import json
+import statistics
+import sys
+
+parser = argparse.ArgumentParser()
+parser.add_argument("baseline")
+parser.add_argument("contender")
+parser.add_argument("--threshold", type=float, default=0.05, help="relative change reported as a regression")
+
+args = parser.parse_args()
+
+
+def load_times(file_name: str) -> dict:
+    with open(file_name) as file:
+        data = json.load(file)
+    times = {}
+    for benchmark in data["benchmarks"]:
+        # Skip the aggregates, the median is computed from the single repetitions instead
+        if benchmark.get("run_type") == "aggregate":
+            continue
+        times.setdefault(benchmark["run_name"], []).append(benchmark["cpu_time"])
+    return {name: statistics.median(values) for name, values in times.items()}
+
+
+baseline = load_times(args.baseline)
+contender = load_times(args.contender)
+regressions = 0
+row_format = "{:<48} {:>14} {:>14} {:>9}"
+print(row_format.format("benchmark", "baseline", "contender", "change"))
+for name, baseline_time in baseline.items():
+    if name not in contender:
+        print(row_format.format(name, "{:.1f}".format(baseline_time), "missing", ""))
+        continue
+    change = contender[name] / baseline_time - 1
+    marker = ""
+    if change > args.threshold:
+        marker = "  SLOWER"
+        regressions += 1
+    elif change < -args.threshold:
+        marker = "  faster"
+    print(row_format.format(name, "{:.1f}".format(baseline_time), "{:.1f}".format(contender[name]),
+                            "{:+.1%}".format(change)) + marker)
+sys.exit(1 if regressions > 0 else 0)
@@ -0,0 +1,44 @@
+#!/usr/bin/python3
+# Runs every instance of a folder with each tree search order and prints a table comparing augmenting path lengths,
+# blossom shrinks and running times, e.g. on the instances listed in test_all.py
+import argparse
+from os import listdir
+import re
+import subprocess
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary")
+parser.add_argument("test_folder")
+parser.add_argument("--orders", default="dfs,bfs,hybrid")
+parser.add_argument("--root-order", default="id")
+
+args = parser.parse_args()
+
+
+def run(file: str, order: str) -> dict:
+    result = subprocess.run([args.binary, args.test_folder + "/" + file, "--tree-search", order,
+                             "--root-order", args.root_order, "--solver-stats"],
+                            capture_output=True, check=True, text=True)
+    first_line = [line for line in result.stdout.splitlines() if line.startswith("p edge")][0]
+    stats = result.stderr
+    path = re.search(r"Augmenting path length: (\S+) on average, (\d+) at most", stats)
+    return {
+        "size": int(first_line.split(" ")[-1]),
+        "shrinks": int(re.search(r"Blossoms shrunk: (\d+)", stats).group(1)),
+        "avg_path": float(path.group(1)),
+        "max_path": int(path.group(2)),
+        "seconds": float(re.search(r"Exact search time: (\S+) s", stats).group(1)),
+    }
+
+
+row_format = "{:<24} {:<7} {:>9} {:>9} {:>9} {:>9} {:>10}"
+print(row_format.format("instance", "order", "matching", "shrinks", "avg path", "max path", "exact [s]"))
+for file in sorted(listdir(args.test_folder)):
+    sizes = set()
+    for order in args.orders.split(","):
+        row = run(file, order)
+        sizes.add(row["size"])
+        print(row_format.format(file, order, row["size"], row["shrinks"], "{:.2f}".format(row["avg_path"]),
+                                row["max_path"], "{:.3f}".format(row["seconds"])))
+    if len(sizes) != 1:
+        print("Search orders disagree on the matching size for " + file)
@@ -0,0 +1,127 @@
+#!/usr/bin/python3
+# Performance regression test for a single instance, registered with CTest by CMakeLists.txt (ctest -L perf).
+#
+# Solves the instance (a file, or a graph written by maxmatching_gen with --generate) a few times, checks the matching
+# size, and appends the best wall time, the peak RSS and the solver counters to a JSON history file. Fails if the
+# matching is not optimal, or if the run is more than --threshold percent slower than the baseline stored in the
+# history. The first run of a test becomes its baseline, --update-baseline (or MAXMATCHING_PERF_UPDATE_BASELINE=1)
+# replaces it after an intended change.
+#
+# Instances without a known optimum are checked against the matching size of the baseline instead, unless the baseline
+# is being replaced (e.g. because the generator changed).
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", help="MaxMatching executable")
+parser.add_argument("--name", required=True, help="test name, the key in the history file")
+parser.add_argument("--instance", help="DIMACS file to solve")
+parser.add_argument("--expected", type=int, help="size of a maximum matching, if known")
+parser.add_argument("--history", required=True, help="JSON file with baselines and previous runs")
+parser.add_argument("--threshold", type=float, default=10, help="allowed slowdown in percent")
+parser.add_argument("--noise-floor", type=float, default=0.05,
+                    help="slowdowns of fewer seconds than this are never reported")
+parser.add_argument("--repetitions", type=int, default=3, help="the fastest of this many runs is recorded")
+parser.add_argument("--build-type", default="", help="recorded to keep baselines of different builds apart")
+parser.add_argument("--update-baseline", action="store_true")
+parser.add_argument("--max-runs", type=int, default=100, help="number of runs kept per test in the history")
+parser.add_argument("--generator", help="maxmatching_gen executable, used with --generate")
+parser.add_argument("--generate", nargs=argparse.REMAINDER,
+                    help="maxmatching_gen arguments to create the instance, has to be the last option")
+
+args = parser.parse_args()
+
+
+def generate_instance(directory: str) -> str:
+    file = os.path.join(directory, args.name + ".dmx")
+    subprocess.run([args.generator] + args.generate + ["--out", file], check=True)
+    return file
+
+
+def run_once(instance: str, stats_file: str) -> dict:
+    """Runs the solver and returns its matching size, wall time, peak RSS and statistics"""
+    with tempfile.TemporaryFile() as output:
+        start = datetime.datetime.now()
+        process = subprocess.Popen([args.binary, instance, "--stats-json", stats_file], stdout=output)
+        # wait4 reports the resource usage of exactly this child
+        _, status, usage = os.wait4(process.pid, 0)
+        wall_seconds = (datetime.datetime.now() - start).total_seconds()
+        process.returncode = os.waitstatus_to_exitcode(status)
+        if process.returncode != 0:
+            sys.exit("Solver failed with exit code " + str(process.returncode))
+        output.seek(0)
+        header = next(line for line in output if line.startswith(b"p edge"))
+    with open(stats_file) as stats:
+        statistics = json.load(stats)
+    return {
+        "matching_size": int(header.split()[-1]),
+        "wall_seconds": wall_seconds,
+        "cpu_seconds": usage.ru_utime + usage.ru_stime,
+        # ru_maxrss is in KiB on Linux
+        "peak_rss_kb": usage.ru_maxrss,
+        "solver": statistics["solver"],
+    }
+
+
+def load_history() -> dict:
+    if not os.path.exists(args.history):
+        return {"tests": {}}
+    with open(args.history) as history_file:
+        return json.load(history_file)
+
+
+def save_history(history: dict):
+    # Write to a temporary file first, an interrupted test must not destroy the history
+    temporary = args.history + ".tmp"
+    with open(temporary, "w") as history_file:
+        json.dump(history, history_file, indent=1)
+    os.replace(temporary, args.history)
+
+
+with tempfile.TemporaryDirectory() as work_directory:
+    instance = generate_instance(work_directory) if args.generate else args.instance
+    stats_file = os.path.join(work_directory, "stats.json")
+    runs = [run_once(instance, stats_file) for _ in range(max(args.repetitions, 1))]
+
+record = min(runs, key=lambda run: run["wall_seconds"])
+record["peak_rss_kb"] = max(run["peak_rss_kb"] for run in runs)
+record["time"] = datetime.datetime.now().isoformat(timespec="seconds")
+record["build_type"] = args.build_type
+
+key = args.name + (" (" + args.build_type + ")" if args.build_type else "")
+history = load_history()
+entry = history["tests"].setdefault(key, {"baseline": None, "runs": []})
+baseline = entry["baseline"]
+update_baseline = args.update_baseline or os.environ.get("MAXMATCHING_PERF_UPDATE_BASELINE") == "1"
+
+failures = []
+if args.expected is not None and record["matching_size"] != args.expected:
+    failures.append("expected a matching of size {}, found {}".format(args.expected, record["matching_size"]))
+elif args.expected is None and baseline and not update_baseline \
+        and record["matching_size"] != baseline["matching_size"]:
+    failures.append("baseline found a matching of size {}, this run {}".format(baseline["matching_size"],
+                                                                               record["matching_size"]))
+print("{}: matching {}, {:.3f} s, peak RSS {} KiB".format(key, record["matching_size"], record["wall_seconds"],
+                                                          record["peak_rss_kb"]))
+if baseline and not update_baseline:
+    change = record["wall_seconds"] / max(baseline["wall_seconds"], 1e-9) - 1
+    print("Baseline from {}: {:.3f} s, change {:+.1%}".format(baseline["time"], baseline["wall_seconds"], change))
+    if change * 100 > args.threshold and record["wall_seconds"] - baseline["wall_seconds"] > args.noise_floor:
+        failures.append("{:.1%} slower than the baseline, allowed are {}%".format(change, args.threshold))
+
+# Failed runs are kept in the history as well, but never become the baseline
+record["passed"] = not failures
+entry["runs"] = (entry["runs"] + [record])[-args.max_runs:]
+if not failures and (baseline is None or update_baseline):
+    entry["baseline"] = record
+    print("Stored as new baseline")
+save_history(history)
+
+for failure in failures:
+    print("FAILED: " + failure)
+sys.exit(1 if failures else 0)
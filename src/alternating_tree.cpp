@@ -4,6 +4,8 @@
 #include <iostream>
 #include <tuple>
 #include "alternating_tree.h"
+#include "perf_counters.h"
+#include "trace.h"
 
 void AlternatingTree::extend(Representative tree_repr, NodeId tree_node, NodeId matched_node) {
     assert(not _needs_reset);
@@ -18,16 +20,28 @@ void AlternatingTree::extend(Representative tree_repr, NodeId tree_node, NodeId
     assert(get_representative(matched_end.id()) == matched_end);
     assert(not is_tree_node(matched_end));
     set_parent(matched_end.id(), matched_repr, matched_node);
+#ifdef MAXMATCHING_STATISTICS
+    if (_statistics) {
+        ++_statistics->extends;
+    }
+#endif
 }
 
 std::vector<NodeId>
 AlternatingTree::shrink_fundamental_circuit(Representative repr_a, NodeId node_a, Representative repr_b,
                                             NodeId node_b) {
+    trace::Scope scope("shrink", trace::Sampling::if_sampled);
+    perf_counters::PhaseScope phase(perf_counters::Phase::shrink);
     assert(not _needs_reset);
     assert(get_representative(repr_a.id()) == repr_a);
     assert(get_representative(repr_b.id()) == repr_b);
     assert(is_even(repr_a));
     assert(is_even(repr_b));
+#ifdef MAXMATCHING_STATISTICS
+    if (_statistics) {
+        ++_statistics->shrinks;
+    }
+#endif
     auto const& fundamental_cycle = find_fundamental_circuit(repr_a, repr_b, node_a, node_b);
     auto[cycle_vertices, cycle_edges] = fundamental_cycle.to_edges_and_reprs();
 
@@ -98,9 +112,13 @@ void AlternatingTree::augment_and_unshrink(Representative tree_repr, NodeId tree
 void AlternatingTree::unshrink() {
     assert(not _needs_reset);
     // There's no need to restore all data structures here, as the tree needs to be reset for the algorithm anyway
-    while (_shrinking.is_shrunken()) {
-        auto const&[odd_cycle, pseudo_node] = _shrinking.expand();
-        _current_matching.expand(pseudo_node, odd_cycle, _shrinking);
+    if (_shrinking.is_shrunken()) {
+        trace::Scope scope("expand", trace::Sampling::if_sampled);
+        perf_counters::PhaseScope phase(perf_counters::Phase::expand);
+        while (_shrinking.is_shrunken()) {
+            auto const&[odd_cycle, pseudo_node] = _shrinking.expand();
+            _current_matching.expand(pseudo_node, odd_cycle, _shrinking);
+        }
     }
     _needs_reset = true;
 }
@@ -147,12 +165,13 @@ bool AlternatingTree::is_root(Representative node) const {
     return get_state(node) == root;
 }
 
-AlternatingTree::AlternatingTree(Matching& matching, NodeId root_node)
+AlternatingTree::AlternatingTree(Matching& matching, NodeId root_node, SolverStatistics* statistics)
         : _current_matching(matching),
-          _shrinking(_current_matching.total_num_nodes()),
+          _shrinking(_current_matching.total_num_nodes(), statistics),
           _parent_edges(_current_matching.total_num_nodes()),
           _depth(_current_matching.total_num_nodes()),
-          _node_states(_current_matching.total_num_nodes()) {
+          _node_states(_current_matching.total_num_nodes()),
+          _statistics(statistics) {
     reset(root_node);
 }
 
@@ -188,6 +207,10 @@ std::vector<NodeId> AlternatingTree::get_tree_vertices() const {
     return _tree_vertices;
 }
 
+size_t AlternatingTree::num_tree_vertices() const {
+    return _tree_vertices.size();
+}
+
 AlternatingTree::FundamentalCircuit AlternatingTree::find_fundamental_circuit(
         Representative repr_a, Representative repr_b, NodeId node_a, NodeId node_b
 ) const {
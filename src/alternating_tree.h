@@ -3,10 +3,14 @@
 
 #include "matching.h"
 #include "representative_vector.h"
+#include "solver_statistics.h"
 
 class AlternatingTree {
 public:
-    AlternatingTree(Matching& matching, NodeId root_node);
+    /**
+     * @param statistics Receives the counters of this tree and its shrinking, may be nullptr
+     */
+    AlternatingTree(Matching& matching, NodeId root_node, SolverStatistics* statistics = nullptr);
 
     /**
      * Shrink a fundamental circuit in the tree.
@@ -54,6 +58,8 @@ public:
 
     [[nodiscard]] std::vector<NodeId> get_tree_vertices() const;
 
+    [[nodiscard]] size_t num_tree_vertices() const;
+
 private:
     static auto constexpr invalid_node = std::numeric_limits<NodeId>::max();
 
@@ -124,6 +130,7 @@ private:
     /// Indicates whether this tree is still in a valid state or needs to be reset before any further operations
     /// (this is the case after unshrinking)
     bool _needs_reset = true;
+    SolverStatistics* _statistics;
 };
 
 #endif //MAXMATCHING_ALTERNATING_TREE_H
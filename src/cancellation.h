@@ -0,0 +1,50 @@
+#ifndef MAXMATCHING_CANCELLATION_H
+#define MAXMATCHING_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * Cooperative cancellation of a running solver: Any thread may call cancel(), the solver checks is_cancelled()
+ * before growing each alternating tree and then stops with the (valid, but possibly not maximum) matching found so
+ * far. A token can be shared by several solvers to stop all of them at once.
+ *
+ * A token can also cancel itself at a deadline. Checking the deadline reads the clock, so it costs a little more than
+ * checking the flag alone.
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void cancel();
+
+    /// The token counts as cancelled from the given point in time on
+    void set_deadline(Clock::time_point deadline);
+
+    [[nodiscard]] bool is_cancelled() const;
+
+private:
+    std::atomic<bool> _cancelled{false};
+    /// Deadline as Clock::rep, the maximum for no deadline
+    std::atomic<Clock::rep> _deadline{Clock::duration::max().count()};
+};
+
+//Inline section
+
+inline void CancellationToken::cancel() {
+    _cancelled.store(true, std::memory_order_relaxed);
+}
+
+inline void CancellationToken::set_deadline(Clock::time_point deadline) {
+    _deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+inline bool CancellationToken::is_cancelled() const {
+    if (_cancelled.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    auto const& deadline = _deadline.load(std::memory_order_relaxed);
+    return deadline != Clock::duration::max().count() and Clock::now().time_since_epoch().count() >= deadline;
+}
+
+#endif //MAXMATCHING_CANCELLATION_H
@@ -0,0 +1,120 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include "checkpoint.h"
+
+namespace {
+
+// Layout (native byte order): magic, number of nodes (32 bit), number of edge ends and the three counters (64 bit
+// each), mate array, allowed flags with 8 nodes per byte
+char const checkpoint_magic[8] = {'M', 'M', 'C', 'K', 'P', 'T', '0', '1'};
+
+template<typename T>
+void write_raw(std::ostream& output, T const* data, size_t count) {
+    output.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template<typename T>
+void read_raw(std::istream& input, T* data, size_t count) {
+    auto const& bytes = static_cast<std::streamsize>(count * sizeof(T));
+    if (not input.read(reinterpret_cast<char*>(data), bytes)) {
+        throw std::runtime_error("Unexpected end of checkpoint");
+    }
+}
+
+} // end of anonymous namespace
+
+void SolverCheckpoint::write(std::ostream& output) const {
+    std::vector<std::uint8_t> packed_allowed((allowed.size() + 7) / 8);
+    for (size_t i = 0; i < allowed.size(); ++i) {
+        if (allowed.at(i)) {
+            packed_allowed.at(i / 8) |= std::uint8_t(1) << (i % 8);
+        }
+    }
+    write_raw(output, checkpoint_magic, sizeof(checkpoint_magic));
+    write_raw(output, &num_nodes, 1);
+    write_raw(output, &num_edge_ends, 1);
+    write_raw(output, &num_blocked_nodes, 1);
+    write_raw(output, &num_initially_blocked_nodes, 1);
+    write_raw(output, &num_blocked_exposed_nodes, 1);
+    write_raw(output, mates.data(), mates.size());
+    write_raw(output, packed_allowed.data(), packed_allowed.size());
+    if (not output) {
+        throw std::runtime_error("Failed to write checkpoint");
+    }
+}
+
+SolverCheckpoint SolverCheckpoint::read(std::istream& input) {
+    char magic[sizeof(checkpoint_magic)];
+    read_raw(input, magic, sizeof(magic));
+    if (std::memcmp(magic, checkpoint_magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a solver checkpoint");
+    }
+    SolverCheckpoint result;
+    read_raw(input, &result.num_nodes, 1);
+    read_raw(input, &result.num_edge_ends, 1);
+    read_raw(input, &result.num_blocked_nodes, 1);
+    read_raw(input, &result.num_initially_blocked_nodes, 1);
+    read_raw(input, &result.num_blocked_exposed_nodes, 1);
+    result.mates.resize(result.num_nodes);
+    read_raw(input, result.mates.data(), result.mates.size());
+    std::vector<std::uint8_t> packed_allowed((result.num_nodes + size_t(7)) / 8);
+    read_raw(input, packed_allowed.data(), packed_allowed.size());
+    result.allowed.resize(result.num_nodes);
+    for (NodeId i = 0; i < result.num_nodes; ++i) {
+        result.allowed.at(i) = (packed_allowed.at(i / 8) >> (i % 8)) & 1;
+    }
+    for (NodeId i = 0; i < result.num_nodes; ++i) {
+        auto const& mate = result.mates.at(i);
+        if (mate != unmatched and (mate >= result.num_nodes or result.mates.at(mate) != i)) {
+            throw std::runtime_error("Inconsistent checkpoint");
+        }
+    }
+    return result;
+}
+
+CheckpointWriter::CheckpointWriter(std::string file_name) : _file_name(std::move(file_name)) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+bool CheckpointWriter::is_idle() const {
+    return not _busy.load();
+}
+
+void CheckpointWriter::write_async(SolverCheckpoint checkpoint) {
+    wait();
+    _busy = true;
+    _thread = std::thread([this, checkpoint = std::move(checkpoint)]() {
+        try {
+            auto const& temporary_name = _file_name + ".tmp";
+            {
+                std::ofstream output(temporary_name, std::ios::binary);
+                if (not output) {
+                    throw std::runtime_error("Failed to open " + temporary_name);
+                }
+                checkpoint.write(output);
+            }
+            if (std::rename(temporary_name.c_str(), _file_name.c_str()) != 0) {
+                throw std::runtime_error("Failed to replace " + _file_name);
+            }
+        } catch (...) {
+            _error = std::current_exception();
+        }
+        _busy = false;
+    });
+}
+
+void CheckpointWriter::wait() {
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_error) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef MAXMATCHING_CHECKPOINT_H
+#define MAXMATCHING_CHECKPOINT_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graph.h"
+
+/**
+ * The state of MaximumMatchingAlgorithm between two trees of the exact search, enough to continue the search after a
+ * restart: the matching, the allowed (not yet blocked) vertices and the counters needed for the upper bound.
+ *
+ * The candidate roots are not part of the state: Resuming builds the root order from the allowed vertices uncovered
+ * by the matching, which are exactly the candidates not yet processed.
+ */
+struct SolverCheckpoint {
+    static auto constexpr unmatched = std::numeric_limits<NodeId>::max();
+
+    NodeId num_nodes = 0;
+    /// Sum of all degrees, detects most attempts to resume on a different graph with the same number of nodes
+    std::uint64_t num_edge_ends = 0;
+    /// mates[v] is the node v is matched to, or unmatched
+    std::vector<NodeId> mates;
+    std::vector<char> allowed;
+    std::uint64_t num_blocked_nodes = 0;
+    std::uint64_t num_initially_blocked_nodes = 0;
+    std::uint64_t num_blocked_exposed_nodes = 0;
+
+    /// Writes the checkpoint in a compact binary format: raw mate array, allowed flags packed into bits
+    void write(std::ostream& output) const;
+
+    /// Reads a checkpoint written by write. Throws an exception if the stream does not contain a valid checkpoint.
+    static SolverCheckpoint read(std::istream& input);
+};
+
+/**
+ * Writes checkpoints to a file on a background thread, so the solver only pays for copying its state. The file is
+ * replaced atomically (written under a temporary name, then renamed), so a job killed while writing still finds the
+ * previous checkpoint.
+ */
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::string file_name);
+
+    /// Waits for the running write, errors of it are lost
+    ~CheckpointWriter();
+
+    CheckpointWriter(CheckpointWriter const&) = delete;
+
+    CheckpointWriter& operator=(CheckpointWriter const&) = delete;
+
+    /// @return Whether no write is in progress, so write_async does not block
+    [[nodiscard]] bool is_idle() const;
+
+    /// Starts writing the checkpoint in the background, waiting for the previous write first
+    void write_async(SolverCheckpoint checkpoint);
+
+    /// Waits for the running write and rethrows its error, if any
+    void wait();
+
+private:
+    std::string _file_name;
+    std::thread _thread;
+    std::atomic<bool> _busy{false};
+    std::exception_ptr _error;
+};
+
+#endif //MAXMATCHING_CHECKPOINT_H
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include "compressed_graph.h"
+#include "dimacs_edge_stream.h"
+
+namespace {
+
+void append_varint(std::vector<std::uint8_t>& data, std::uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::ifstream open_file(std::string const& file_name) {
+    std::ifstream input(file_name);
+    if (not input) {
+        throw std::runtime_error("Failed to open " + file_name);
+    }
+    return input;
+}
+
+NodeId read_dimacs_num_nodes(std::string const& file_name) {
+    auto input = open_file(file_name);
+    return DimacsEdgeStream(input).num_nodes();
+}
+
+// Calls on_edge for every edge of the DIMACS file
+template<typename EdgeCallback>
+void read_dimacs_pass(std::string const& file_name, EdgeCallback&& on_edge) {
+    auto input = open_file(file_name);
+    DimacsEdgeStream edges(input);
+    while (auto const& edge = edges.next_edge()) {
+        if (edge->first == edge->second) {
+            throw std::runtime_error("Graph class does not support loops!");
+        }
+        on_edge(edge->first, edge->second);
+    }
+}
+
+} // end of anonymous namespace
+
+CompressedGraph::CompressedGraph(Graph const& graph) {
+    compress(graph);
+}
+
+CompressedGraph::CompressedGraph(CsrGraphView const& graph) {
+    compress(graph);
+}
+
+template<typename GraphT>
+void CompressedGraph::compress(GraphT const& graph) {
+    _offsets.reserve(graph.num_nodes() + size_t(1));
+    std::vector<NodeId> neighbors;
+    for (NodeId i = 0; i < graph.num_nodes(); ++i) {
+        auto const& node_neighbors = graph.node(i).neighbors();
+        neighbors.assign(node_neighbors.begin(), node_neighbors.end());
+        append_node(neighbors.data(), neighbors.data() + neighbors.size());
+    }
+    _data.shrink_to_fit();
+}
+
+CompressedGraph CompressedGraph::read_dimacs(std::string const& file_name, size_t max_buffered_neighbors) {
+    CompressedGraph result;
+    std::vector<EdgeIndex> degrees(read_dimacs_num_nodes(file_name));
+    read_dimacs_pass(file_name, [&degrees](NodeId end_a, NodeId end_b) {
+        ++degrees.at(end_a);
+        ++degrees.at(end_b);
+    });
+    ++result._num_passes;
+    auto const& num_nodes = static_cast<NodeId>(degrees.size());
+    result._offsets.reserve(num_nodes + size_t(1));
+    // Collect the adjacency lists of a block of nodes [block_begin, block_end) per pass in CSR format
+    std::vector<EdgeIndex> block_offsets;
+    std::vector<NodeId> block_targets;
+    NodeId block_begin = 0;
+    while (block_begin < num_nodes) {
+        NodeId block_end = block_begin;
+        block_offsets.assign(1, 0);
+        // Always take at least one node, even if its degree exceeds the buffer size
+        do {
+            block_offsets.push_back(block_offsets.back() + degrees.at(block_end));
+            ++block_end;
+        } while (block_end < num_nodes and block_offsets.back() + degrees.at(block_end) <= max_buffered_neighbors);
+        block_targets.resize(block_offsets.back());
+        auto const& add_end = [&](NodeId node, NodeId neighbor) {
+            if (node >= block_begin and node < block_end) {
+                block_targets.at(block_offsets.at(node - block_begin)++) = neighbor;
+            }
+        };
+        read_dimacs_pass(file_name, [&add_end](NodeId end_a, NodeId end_b) {
+            add_end(end_a, end_b);
+            add_end(end_b, end_a);
+        });
+        ++result._num_passes;
+        // After filling, offset i is the end of node i within the block
+        auto* block_start = block_targets.data();
+        for (NodeId node = block_begin; node < block_end; ++node) {
+            auto* node_end = block_targets.data() + block_offsets.at(node - block_begin);
+            result.append_node(block_start, node_end);
+            block_start = node_end;
+        }
+        block_begin = block_end;
+    }
+    result._data.shrink_to_fit();
+    return result;
+}
+
+size_t CompressedGraph::memory_bytes() const {
+    return _data.capacity() * sizeof(std::uint8_t) + _offsets.capacity() * sizeof(EdgeIndex);
+}
+
+size_t CompressedGraph::num_passes() const {
+    return _num_passes;
+}
+
+void CompressedGraph::append_node(NodeId* neighbors_begin, NodeId* neighbors_end) {
+    auto const& node = static_cast<NodeId>(_offsets.size() - 1);
+    std::sort(neighbors_begin, neighbors_end);
+    append_varint(_data, neighbors_end - neighbors_begin);
+    NodeId previous = node;
+    bool first = true;
+    for (auto const* it = neighbors_begin; it != neighbors_end; ++it) {
+        if (first) {
+            append_varint(_data, zigzag(static_cast<std::int64_t>(*it) - static_cast<std::int64_t>(node)));
+            first = false;
+        } else {
+            append_varint(_data, *it - previous);
+        }
+        previous = *it;
+    }
+    _offsets.push_back(_data.size());
+}
@@ -0,0 +1,208 @@
+#ifndef MAXMATCHING_COMPRESSED_GRAPH_H
+#define MAXMATCHING_COMPRESSED_GRAPH_H
+
+#include <iterator>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "csr_graph.h"
+
+/**
+ * Iterates over a delta encoded neighbor list of a CompressedGraph, decoding one neighbor per step.
+ */
+class CompressedNeighborIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = NodeId;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NodeId const*;
+    using reference = NodeId;
+
+    /// End iterator
+    CompressedNeighborIterator() = default;
+
+    /**
+     * @param data Start of the encoded neighbors (after the degree)
+     * @param degree Number of encoded neighbors
+     * @param node The node the neighbors belong to, the first neighbor is encoded relative to it
+     */
+    CompressedNeighborIterator(std::uint8_t const* data, size_type degree, NodeId node);
+
+    NodeId operator*() const;
+
+    CompressedNeighborIterator& operator++();
+
+    bool operator==(CompressedNeighborIterator const& other) const;
+
+    bool operator!=(CompressedNeighborIterator const& other) const;
+
+private:
+    std::uint8_t const* _data = nullptr;
+    /// Number of neighbors not yet passed, including the current one. All end iterators have 0 remaining neighbors
+    size_type _remaining = 0;
+    NodeId _current = 0;
+};
+
+class CompressedNeighborRange {
+public:
+    CompressedNeighborRange(std::uint8_t const* data, size_type degree, NodeId node);
+
+    [[nodiscard]] CompressedNeighborIterator begin() const;
+
+    [[nodiscard]] CompressedNeighborIterator end() const;
+
+private:
+    std::uint8_t const* _data;
+    size_type _degree;
+    NodeId _node;
+};
+
+/**
+ * The counterpart of Node for CompressedGraph.
+ */
+class CompressedNode {
+public:
+    CompressedNode(std::uint8_t const* data, NodeId id);
+
+    [[nodiscard]] size_type degree() const;
+
+    [[nodiscard]] CompressedNeighborRange neighbors() const;
+
+private:
+    std::uint8_t const* _neighbor_data;
+    size_type _degree;
+    NodeId _id;
+};
+
+/**
+ * Read-only graph storing sorted adjacency lists as variable length integers in one byte array. The first neighbor is
+ * stored as the (zigzag encoded) difference to the node itself, all further neighbors as the difference to the
+ * previous neighbor, so lists of nearby ids (as in road networks) take about one byte per entry. Each list is preceded
+ * by the degree of the node.
+ *
+ * This provides the same interface as Graph as far as the matching algorithms are concerned. Neighbors are decoded
+ * while iterating, so iterating is slower than for Graph or CsrGraphView.
+ */
+class CompressedGraph {
+public:
+    explicit CompressedGraph(Graph const& graph);
+
+    explicit CompressedGraph(CsrGraphView const& graph);
+
+    /**
+     * Builds the compressed graph directly from a DIMACS file without building an uncompressed graph first. The file
+     * is read several times: Once to count degrees and then once per block of nodes whose adjacency lists fit into
+     * max_buffered_neighbors entries. Peak memory is thus the compressed graph plus this buffer.
+     */
+    static CompressedGraph read_dimacs(std::string const& file_name, size_t max_buffered_neighbors = size_t(1) << 26);
+
+    [[nodiscard]] NodeId num_nodes() const;
+
+    [[nodiscard]] CompressedNode node(NodeId id) const;
+
+    /// @return The number of bytes used by the arrays of this graph
+    [[nodiscard]] size_t memory_bytes() const;
+
+    /// @return The number of passes over the input used by read_dimacs, 0 if the graph was not built by it
+    [[nodiscard]] size_t num_passes() const;
+
+private:
+    CompressedGraph() = default;
+
+    /// Appends the adjacency list of the next node, sorting the given neighbors in the process
+    void append_node(NodeId* neighbors_begin, NodeId* neighbors_end);
+
+    template<typename GraphT>
+    void compress(GraphT const& graph);
+
+    std::vector<std::uint8_t> _data;
+    /// Start of the data of node i in _data, with one additional entry for the end of the last node
+    std::vector<EdgeIndex> _offsets{0};
+    size_t _num_passes = 0;
+};
+
+//Inline section
+
+namespace compressed_graph_detail {
+
+inline std::uint64_t read_varint(std::uint8_t const*& data) {
+    // Most deltas fit into a single byte, so handle that case without a loop
+    std::uint64_t result = *data++;
+    if (result < 0x80) {
+        return result;
+    }
+    result &= 0x7f;
+    unsigned shift = 7;
+    std::uint8_t byte{};
+    do {
+        byte = *data++;
+        result |= std::uint64_t(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return result;
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace compressed_graph_detail
+
+inline CompressedNeighborIterator::CompressedNeighborIterator(std::uint8_t const* data, size_type degree, NodeId node)
+        : _data(data), _remaining(degree) {
+    if (_remaining > 0) {
+        using namespace compressed_graph_detail;
+        _current = static_cast<NodeId>(node + unzigzag(read_varint(_data)));
+    }
+}
+
+inline NodeId CompressedNeighborIterator::operator*() const {
+    return _current;
+}
+
+inline CompressedNeighborIterator& CompressedNeighborIterator::operator++() {
+    if (--_remaining > 0) {
+        _current += static_cast<NodeId>(compressed_graph_detail::read_varint(_data));
+    }
+    return *this;
+}
+
+inline bool CompressedNeighborIterator::operator==(CompressedNeighborIterator const& other) const {
+    return _remaining == other._remaining;
+}
+
+inline bool CompressedNeighborIterator::operator!=(CompressedNeighborIterator const& other) const {
+    return not(*this == other);
+}
+
+inline CompressedNeighborRange::CompressedNeighborRange(std::uint8_t const* data, size_type degree, NodeId node)
+        : _data(data), _degree(degree), _node(node) {}
+
+inline CompressedNeighborIterator CompressedNeighborRange::begin() const {
+    return CompressedNeighborIterator(_data, _degree, _node);
+}
+
+inline CompressedNeighborIterator CompressedNeighborRange::end() const {
+    return CompressedNeighborIterator();
+}
+
+inline CompressedNode::CompressedNode(std::uint8_t const* data, NodeId id)
+        : _neighbor_data(data), _degree(compressed_graph_detail::read_varint(_neighbor_data)), _id(id) {}
+
+inline size_type CompressedNode::degree() const {
+    return _degree;
+}
+
+inline CompressedNeighborRange CompressedNode::neighbors() const {
+    return CompressedNeighborRange(_neighbor_data, _degree, _id);
+}
+
+inline NodeId CompressedGraph::num_nodes() const {
+    return _offsets.size() - 1;
+}
+
+inline CompressedNode CompressedGraph::node(NodeId id) const {
+    return CompressedNode(_data.data() + _offsets[id], id);
+}
+
+#endif //MAXMATCHING_COMPRESSED_GRAPH_H
@@ -0,0 +1,110 @@
+#include <stdexcept>
+#include <istream>
+#include <ostream>
+#include <cstring>
+#include "csr_graph.h"
+
+namespace {
+
+// Snapshot layout (native byte order): magic, number of nodes (32 bit), number of targets (64 bit), offsets, targets
+char const snapshot_magic[8] = {'M', 'M', 'C', 'S', 'R', '0', '0', '1'};
+
+template<typename T>
+void write_raw(std::ostream& output, T const* data, size_t count) {
+    output.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template<typename T>
+void read_raw(std::istream& input, T* data, size_t count) {
+    auto const& bytes = static_cast<std::streamsize>(count * sizeof(T));
+    if (not input.read(reinterpret_cast<char*>(data), bytes)) {
+        throw std::runtime_error("Unexpected end of graph snapshot");
+    }
+}
+
+} // end of anonymous namespace
+
+void CsrGraph::assign_from_edge_list(NodeId num_nodes, NodeId const* edge_ends, size_t num_edges) {
+    _num_nodes = num_nodes;
+    // Counting sort by the first end: count degrees, turn them into start offsets and then fill in the targets
+    _offsets.assign(num_nodes + size_t(1), 0);
+    for (size_t i = 0; i < 2 * num_edges; ++i) {
+        if (edge_ends[i] >= num_nodes) {
+            throw std::runtime_error("Node id in edge list exceeds the number of nodes");
+        }
+        ++_offsets.at(edge_ends[i] + size_t(1));
+    }
+    for (NodeId i = 0; i < num_nodes; ++i) {
+        _offsets.at(i + size_t(1)) += _offsets.at(i);
+    }
+    _targets.resize(2 * num_edges);
+    // Use the start offsets as insertion positions, afterwards offset i contains the end of node i
+    for (size_t i = 0; i < num_edges; ++i) {
+        auto const& end_a = edge_ends[2 * i];
+        auto const& end_b = edge_ends[2 * i + 1];
+        if (end_a == end_b) {
+            throw std::runtime_error("Graph class does not support loops!");
+        }
+        _targets.at(_offsets.at(end_a)++) = end_b;
+        _targets.at(_offsets.at(end_b)++) = end_a;
+    }
+    // Shift back to get the start offsets again
+    for (NodeId i = num_nodes; i > 0; --i) {
+        _offsets.at(i) = _offsets.at(i - 1);
+    }
+    _offsets.at(0) = 0;
+}
+
+void CsrGraph::assign_from_graph(Graph const& graph) {
+    _num_nodes = graph.num_nodes();
+    _offsets.resize(_num_nodes + size_t(1));
+    _targets.clear();
+    _offsets.at(0) = 0;
+    for (NodeId i = 0; i < _num_nodes; ++i) {
+        auto const& neighbors = graph.node(i).neighbors();
+        _targets.insert(_targets.end(), neighbors.begin(), neighbors.end());
+        _offsets.at(i + size_t(1)) = _targets.size();
+    }
+}
+
+void CsrGraph::write_snapshot(std::ostream& output) const {
+    EdgeIndex const num_targets = _targets.size();
+    write_raw(output, snapshot_magic, sizeof(snapshot_magic));
+    write_raw(output, &_num_nodes, 1);
+    write_raw(output, &num_targets, 1);
+    write_raw(output, _offsets.data(), _offsets.size());
+    write_raw(output, _targets.data(), _targets.size());
+    if (not output) {
+        throw std::runtime_error("Failed to write graph snapshot");
+    }
+}
+
+CsrGraph CsrGraph::read_snapshot(std::istream& input) {
+    char magic[sizeof(snapshot_magic)];
+    read_raw(input, magic, sizeof(magic));
+    if (std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a graph snapshot");
+    }
+    CsrGraph result;
+    EdgeIndex num_targets{};
+    read_raw(input, &result._num_nodes, 1);
+    read_raw(input, &num_targets, 1);
+    result._offsets.resize(result._num_nodes + size_t(1));
+    result._targets.resize(num_targets);
+    read_raw(input, result._offsets.data(), result._offsets.size());
+    read_raw(input, result._targets.data(), result._targets.size());
+    if (result._offsets.front() != 0 or result._offsets.back() != num_targets) {
+        throw std::runtime_error("Inconsistent graph snapshot");
+    }
+    return result;
+}
+
+bool CsrGraph::is_snapshot(std::istream& input) {
+    char magic[sizeof(snapshot_magic)]{};
+    auto const& start = input.tellg();
+    input.read(magic, sizeof(magic));
+    bool const result = input and std::memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+    input.clear();
+    input.seekg(start);
+    return result;
+}
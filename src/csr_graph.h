@@ -0,0 +1,158 @@
+#ifndef MAXMATCHING_CSR_GRAPH_H
+#define MAXMATCHING_CSR_GRAPH_H
+
+#include <iosfwd>
+#include <vector>
+#include "graph.h"
+
+/// Index into the neighbor array of a CSR graph. 64 bit since the number of edge ends can exceed the node id range
+using EdgeIndex = std::uint64_t;
+
+/**
+ * A contiguous range of neighbor ids, as returned by CsrNode::neighbors.
+ */
+class NeighborRange {
+public:
+    NeighborRange(NodeId const* begin, NodeId const* end);
+
+    [[nodiscard]] NodeId const* begin() const;
+
+    [[nodiscard]] NodeId const* end() const;
+
+    [[nodiscard]] size_type size() const;
+
+private:
+    NodeId const* _begin;
+    NodeId const* _end;
+};
+
+/**
+ * The counterpart of Node for CsrGraphView. This only refers to memory owned by someone else.
+ */
+class CsrNode {
+public:
+    explicit CsrNode(NeighborRange neighbors);
+
+    [[nodiscard]] size_type degree() const;
+
+    [[nodiscard]] NeighborRange neighbors() const;
+
+private:
+    NeighborRange _neighbors;
+};
+
+/**
+ * Non-owning view of a graph in compressed sparse row format: The neighbors of node i are
+ * targets[offsets[i]], ..., targets[offsets[i + 1] - 1]. Each undirected edge has to be listed at both of its ends.
+ * The arrays are not copied, so they need to outlive the view and every algorithm using it.
+ *
+ * This provides the same interface as Graph as far as the matching algorithms are concerned.
+ */
+class CsrGraphView {
+public:
+    /**
+     * @param num_nodes The number of nodes
+     * @param offsets Array of num_nodes + 1 offsets into targets
+     * @param targets Array of neighbor ids
+     */
+    CsrGraphView(NodeId num_nodes, EdgeIndex const* offsets, NodeId const* targets);
+
+    [[nodiscard]] NodeId num_nodes() const;
+
+    [[nodiscard]] CsrNode node(NodeId id) const;
+
+private:
+    NodeId _num_nodes;
+    EdgeIndex const* _offsets;
+    NodeId const* _targets;
+};
+
+/**
+ * Owning storage for a CSR graph, e.g. built from an edge list. Algorithms run on the view returned by view().
+ */
+class CsrGraph {
+public:
+    CsrGraph() = default;
+
+    /**
+     * Builds the CSR arrays from an edge list, reusing the memory already owned by this object.
+     * @param edge_ends Array of 2 * num_edges node ids, edge i is {edge_ends[2i], edge_ends[2i + 1]}
+     * Throws an exception on loops and out of range node ids.
+     */
+    void assign_from_edge_list(NodeId num_nodes, NodeId const* edge_ends, size_t num_edges);
+
+    void assign_from_graph(Graph const& graph);
+
+    [[nodiscard]] CsrGraphView view() const;
+
+    /// @return The number of (undirected) edges
+    [[nodiscard]] size_t num_edges() const;
+
+    /**
+     * Writes the CSR arrays in a binary format that can be loaded without any parsing.
+     */
+    void write_snapshot(std::ostream& output) const;
+
+    /**
+     * Reads a graph written by write_snapshot. Throws an exception if the stream does not contain a valid snapshot.
+     */
+    static CsrGraph read_snapshot(std::istream& input);
+
+    /**
+     * @return Whether the stream starts with the snapshot header. The stream needs to be seekable, its position is
+     * restored afterwards.
+     */
+    static bool is_snapshot(std::istream& input);
+
+private:
+    NodeId _num_nodes = 0;
+    std::vector<EdgeIndex> _offsets{0};
+    std::vector<NodeId> _targets;
+};
+
+//Inline section
+
+inline NeighborRange::NeighborRange(NodeId const* begin, NodeId const* end) : _begin(begin), _end(end) {}
+
+inline NodeId const* NeighborRange::begin() const {
+    return _begin;
+}
+
+inline NodeId const* NeighborRange::end() const {
+    return _end;
+}
+
+inline size_type NeighborRange::size() const {
+    return _end - _begin;
+}
+
+inline CsrNode::CsrNode(NeighborRange neighbors) : _neighbors(neighbors) {}
+
+inline size_type CsrNode::degree() const {
+    return _neighbors.size();
+}
+
+inline NeighborRange CsrNode::neighbors() const {
+    return _neighbors;
+}
+
+inline CsrGraphView::CsrGraphView(NodeId num_nodes, EdgeIndex const* offsets, NodeId const* targets)
+        : _num_nodes(num_nodes), _offsets(offsets), _targets(targets) {}
+
+inline NodeId CsrGraphView::num_nodes() const {
+    return _num_nodes;
+}
+
+inline CsrNode CsrGraphView::node(NodeId id) const {
+    return CsrNode(NeighborRange(_targets + _offsets[id], _targets + _offsets[id + 1]));
+}
+
+inline CsrGraphView CsrGraph::view() const {
+    return CsrGraphView(_num_nodes, _offsets.data(), _targets.data());
+}
+
+inline size_t CsrGraph::num_edges() const {
+    return _targets.size() / 2;
+}
+
+#endif //MAXMATCHING_CSR_GRAPH_H
@@ -0,0 +1,187 @@
+/**
+ * Load generator for the solver daemon: Sends requests for one graph from several concurrent connections and reports
+ * latency percentiles and throughput.
+ *
+ * Usage: maxmatching_loadgen <socket> <graph name> [--load <file>] [--requests N] [--connections N]
+ *                            [--type solve|warm-start|subgraph] [--subgraph-fraction F] [--seed S]
+ */
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "daemon_protocol.h"
+
+using namespace daemon_protocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string socket_path;
+    std::string graph_name;
+    std::string load_file;
+    size_t num_requests = 1000;
+    size_t num_connections = 1;
+    RequestType type = RequestType::solve;
+    double subgraph_fraction = 0.5;
+    unsigned long seed = 0;
+};
+
+Options parse_arguments(int argc, char** argv) {
+    if (argc < 3) {
+        throw std::runtime_error("Expected the socket path and the graph name");
+    }
+    Options options;
+    options.socket_path = argv[1];
+    options.graph_name = argv[2];
+    for (int i = 3; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + arg);
+        }
+        std::string const value = argv[++i];
+        if (arg == "--load") {
+            options.load_file = value;
+        } else if (arg == "--requests") {
+            options.num_requests = std::stoull(value);
+        } else if (arg == "--connections") {
+            options.num_connections = std::max<size_t>(std::stoull(value), 1);
+        } else if (arg == "--subgraph-fraction") {
+            options.subgraph_fraction = std::stod(value);
+        } else if (arg == "--seed") {
+            options.seed = std::stoul(value);
+        } else if (arg == "--type" and value == "solve") {
+            options.type = RequestType::solve;
+        } else if (arg == "--type" and value == "warm-start") {
+            options.type = RequestType::warm_start;
+        } else if (arg == "--type" and value == "subgraph") {
+            options.type = RequestType::subgraph;
+        } else {
+            throw std::runtime_error("Unexpected argument " + arg + " " + value);
+        }
+    }
+    return options;
+}
+
+/// Sends a request and waits for its response, which has to be successful
+Response round_trip(int fd, Request const& request) {
+    write_request(fd, request);
+    Response response;
+    if (not read_response(fd, response)) {
+        throw std::runtime_error("Daemon closed the connection");
+    }
+    if (response.status != Status::ok) {
+        throw std::runtime_error("Request failed: " + std::string(response.payload.begin(), response.payload.end()));
+    }
+    return response;
+}
+
+/// Builds the request sent repeatedly by one connection
+Request make_request(Options const& options, int fd, size_t connection_index) {
+    Request request;
+    request.type = options.type;
+    request.graph_name = options.graph_name;
+    if (options.type == RequestType::solve) {
+        return request;
+    }
+    // Warm starts and subgraphs need the mate array (for the initial matching) or the number of nodes
+    Request solve_request{RequestType::solve, 0, options.graph_name, {}};
+    auto const& mates = read_from_payload<std::uint32_t>(round_trip(fd, solve_request).payload,
+                                                         sizeof(std::uint64_t));
+    if (options.type == RequestType::warm_start) {
+        append_to_payload(request.payload, mates.data(), mates.size());
+    } else {
+        std::mt19937 random(options.seed + connection_index);
+        std::bernoulli_distribution in_subgraph(options.subgraph_fraction);
+        for (std::uint32_t i = 0; i < mates.size(); ++i) {
+            if (in_subgraph(random)) {
+                append_to_payload(request.payload, &i, 1);
+            }
+        }
+    }
+    return request;
+}
+
+void run_connection(Options const& options, size_t connection_index, size_t num_requests,
+                    std::vector<double>& latencies_ms) {
+    int const fd = connect_to(options.socket_path);
+    try {
+        auto request = make_request(options, fd, connection_index);
+        for (size_t i = 0; i < num_requests; ++i) {
+            request.request_id = i;
+            auto const& start = Clock::now();
+            round_trip(fd, request);
+            auto const& duration = std::chrono::duration<double, std::milli>(Clock::now() - start);
+            latencies_ms.push_back(duration.count());
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+double percentile(std::vector<double> const& sorted_values, double fraction) {
+    if (sorted_values.empty()) {
+        return 0;
+    }
+    auto const& index = static_cast<size_t>(fraction * static_cast<double>(sorted_values.size() - 1) + 0.5);
+    return sorted_values.at(index);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto const& options = parse_arguments(argc, argv);
+        if (not options.load_file.empty()) {
+            int const fd = connect_to(options.socket_path);
+            Request load{RequestType::load_graph, 0, options.graph_name,
+                         std::vector<char>(options.load_file.begin(), options.load_file.end())};
+            round_trip(fd, load);
+            ::close(fd);
+        }
+        std::vector<std::vector<double>> latencies(options.num_connections);
+        std::vector<std::string> errors(options.num_connections);
+        std::vector<std::thread> threads;
+        auto const& start = Clock::now();
+        for (size_t i = 0; i < options.num_connections; ++i) {
+            auto const& share = options.num_requests / options.num_connections
+                                + (i < options.num_requests % options.num_connections ? 1 : 0);
+            threads.emplace_back([&, i, share]() {
+                try {
+                    run_connection(options, i, share, latencies.at(i));
+                } catch (std::exception const& xcp) {
+                    errors.at(i) = xcp.what();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto const& wall_time = std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto const& error : errors) {
+            if (not error.empty()) {
+                throw std::runtime_error(error);
+            }
+        }
+        std::vector<double> all_latencies;
+        for (auto const& connection_latencies : latencies) {
+            all_latencies.insert(all_latencies.end(), connection_latencies.begin(), connection_latencies.end());
+        }
+        std::sort(all_latencies.begin(), all_latencies.end());
+        std::cout << "Requests: " << all_latencies.size() << " over " << options.num_connections << " connections\n"
+                  << "p50 latency: " << percentile(all_latencies, 0.5) << " ms\n"
+                  << "p99 latency: " << percentile(all_latencies, 0.99) << " ms\n"
+                  << "Throughput: " << static_cast<double>(all_latencies.size()) / wall_time << " requests/s\n";
+    } catch (std::exception const& xcp) {
+        std::cerr << "Caught exception: " << xcp.what() << '\n';
+        return 1;
+    }
+}
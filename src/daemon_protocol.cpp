@@ -0,0 +1,148 @@
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "daemon_protocol.h"
+
+namespace daemon_protocol {
+
+namespace {
+
+// Reads exactly size bytes. Returns false if the connection was closed before the first byte and allow_eof is set.
+bool read_exactly(int fd, void* data, size_t size, bool allow_eof) {
+    auto* bytes = static_cast<char*>(data);
+    size_t done = 0;
+    while (done < size) {
+        auto const& result = ::read(fd, bytes + done, size - done);
+        if (result < 0 and errno == EINTR) {
+            continue;
+        } else if (result < 0) {
+            throw std::runtime_error(std::string("Socket read failed: ") + std::strerror(errno));
+        } else if (result == 0) {
+            if (done == 0 and allow_eof) {
+                return false;
+            }
+            throw std::runtime_error("Connection closed in the middle of a message");
+        }
+        done += result;
+    }
+    return true;
+}
+
+void write_exactly(int fd, void const* data, size_t size) {
+    auto const* bytes = static_cast<char const*>(data);
+    size_t done = 0;
+    while (done < size) {
+        // MSG_NOSIGNAL: A client hanging up should result in an error, not in SIGPIPE killing the daemon
+        auto const& result = ::send(fd, bytes + done, size - done, MSG_NOSIGNAL);
+        if (result < 0 and errno == EINTR) {
+            continue;
+        } else if (result < 0) {
+            throw std::runtime_error(std::string("Socket write failed: ") + std::strerror(errno));
+        }
+        done += result;
+    }
+}
+
+void check_length(std::uint64_t length) {
+    if (length > max_message_length) {
+        throw std::runtime_error("Message exceeds the maximum length");
+    }
+}
+
+sockaddr_un make_address(std::string const& socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socket_path);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+    return address;
+}
+
+} // end of anonymous namespace
+
+bool read_request(int fd, Request& request) {
+    RequestHeader header{};
+    if (not read_exactly(fd, &header, sizeof(header), true)) {
+        return false;
+    }
+    if (header.magic != magic) {
+        throw std::runtime_error("Invalid request header");
+    }
+    check_length(header.name_length);
+    check_length(header.payload_length);
+    request.type = header.type;
+    request.request_id = header.request_id;
+    request.graph_name.resize(header.name_length);
+    read_exactly(fd, request.graph_name.data(), request.graph_name.size(), false);
+    request.payload.resize(header.payload_length);
+    read_exactly(fd, request.payload.data(), request.payload.size(), false);
+    return true;
+}
+
+void write_request(int fd, Request const& request) {
+    RequestHeader const header{
+            magic, request.type, request.request_id, static_cast<std::uint32_t>(request.graph_name.size()), 0,
+            request.payload.size()
+    };
+    write_exactly(fd, &header, sizeof(header));
+    write_exactly(fd, request.graph_name.data(), request.graph_name.size());
+    write_exactly(fd, request.payload.data(), request.payload.size());
+}
+
+bool read_response(int fd, Response& response) {
+    ResponseHeader header{};
+    if (not read_exactly(fd, &header, sizeof(header), true)) {
+        return false;
+    }
+    if (header.magic != magic) {
+        throw std::runtime_error("Invalid response header");
+    }
+    check_length(header.payload_length);
+    response.status = header.status;
+    response.request_id = header.request_id;
+    response.payload.resize(header.payload_length);
+    read_exactly(fd, response.payload.data(), response.payload.size(), false);
+    return true;
+}
+
+void write_response(int fd, Response const& response) {
+    ResponseHeader const header{magic, response.status, response.request_id, response.payload.size()};
+    write_exactly(fd, &header, sizeof(header));
+    write_exactly(fd, response.payload.data(), response.payload.size());
+}
+
+int listen_on(std::string const& socket_path) {
+    auto const& address = make_address(socket_path);
+    int const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+    ::unlink(socket_path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0
+        or ::listen(fd, SOMAXCONN) != 0) {
+        auto const& error = std::string(std::strerror(errno));
+        ::close(fd);
+        throw std::runtime_error("Failed to listen on " + socket_path + ": " + error);
+    }
+    return fd;
+}
+
+int connect_to(std::string const& socket_path) {
+    auto const& address = make_address(socket_path);
+    int const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        auto const& error = std::string(std::strerror(errno));
+        ::close(fd);
+        throw std::runtime_error("Failed to connect to " + socket_path + ": " + error);
+    }
+    return fd;
+}
+
+} // namespace daemon_protocol
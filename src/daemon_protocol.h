@@ -0,0 +1,113 @@
+#ifndef MAXMATCHING_DAEMON_PROTOCOL_H
+#define MAXMATCHING_DAEMON_PROTOCOL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Binary protocol spoken between the solver daemon (SolverDaemon) and its clients over a Unix domain socket.
+ * All integers are in native byte order since both ends run on the same machine.
+ *
+ * A request is a RequestHeader followed by name_length bytes of graph name and payload_length bytes of payload.
+ * A response is a ResponseHeader followed by payload_length bytes of payload. Responses carry the request_id of their
+ * request, since requests pipelined on one connection may be answered out of order.
+ *
+ * Payloads by request type:
+ * - load_graph: request: path of a DIMACS file or graph snapshot; response: number of nodes (uint64_t)
+ * - solve: request: empty; response: matching size (uint64_t) followed by the mate array (uint32_t per node,
+ * UINT32_MAX for unmatched nodes)
+ * - warm_start: request: initial mate array in the same format; response: as for solve
+ * - subgraph: request: ids of the vertices of the induced subgraph (uint32_t each); response: as for solve
+ * - unload_graph, shutdown: both empty
+ * If the status of a response is error, the payload is an error message instead.
+ */
+namespace daemon_protocol {
+
+std::uint32_t constexpr magic = 0x514d4d4d; // "MMMQ"
+
+enum class RequestType : std::uint32_t {
+    load_graph = 1,
+    solve = 2,
+    warm_start = 3,
+    subgraph = 4,
+    unload_graph = 5,
+    shutdown = 6,
+};
+
+enum class Status : std::uint32_t {
+    ok = 0,
+    error = 1,
+};
+
+struct RequestHeader {
+    std::uint32_t magic;
+    RequestType type;
+    std::uint64_t request_id;
+    std::uint32_t name_length;
+    std::uint32_t reserved;
+    std::uint64_t payload_length;
+};
+
+struct ResponseHeader {
+    std::uint32_t magic;
+    Status status;
+    std::uint64_t request_id;
+    std::uint64_t payload_length;
+};
+
+struct Request {
+    RequestType type{};
+    std::uint64_t request_id = 0;
+    std::string graph_name;
+    std::vector<char> payload;
+};
+
+struct Response {
+    Status status = Status::ok;
+    std::uint64_t request_id = 0;
+    std::vector<char> payload;
+};
+
+/// Upper bound on names and payloads accepted from the socket, to reject garbage before allocating memory for it
+std::uint64_t constexpr max_message_length = std::uint64_t(1) << 36;
+
+/**
+ * @return false if the connection was closed before the first byte of the request, throws on any other error
+ */
+bool read_request(int fd, Request& request);
+
+void write_request(int fd, Request const& request);
+
+/**
+ * @return false if the connection was closed before the first byte of the response, throws on any other error
+ */
+bool read_response(int fd, Response& response);
+
+void write_response(int fd, Response const& response);
+
+/// Creates a listening socket at the given path, replacing a stale socket file
+int listen_on(std::string const& socket_path);
+
+int connect_to(std::string const& socket_path);
+
+/// Appends the raw bytes of the given values to a payload
+template<typename T>
+void append_to_payload(std::vector<char>& payload, T const* values, size_t count) {
+    auto const* bytes = reinterpret_cast<char const*>(values);
+    payload.insert(payload.end(), bytes, bytes + count * sizeof(T));
+}
+
+/// Interprets a payload (starting at the given byte offset) as an array of T
+template<typename T>
+std::vector<T> read_from_payload(std::vector<char> const& payload, size_t offset = 0) {
+    std::vector<T> result(offset < payload.size() ? (payload.size() - offset) / sizeof(T) : 0);
+    std::copy(payload.begin() + offset, payload.begin() + offset + result.size() * sizeof(T),
+              reinterpret_cast<char*>(result.data()));
+    return result;
+}
+
+} // namespace daemon_protocol
+
+#endif //MAXMATCHING_DAEMON_PROTOCOL_H
@@ -0,0 +1,77 @@
+#include <istream>
+#include <stdexcept>
+#include <charconv>
+#include "dimacs_edge_stream.h"
+
+namespace {
+
+// Using a function for converting the DIMACS node ids to and from our node ids
+// makes the in and output code more understandable.
+NodeId from_dimacs_id(size_type dimacs_node_id) {
+    if (dimacs_node_id <= 0) {
+        throw std::runtime_error("Non-positive DIMACS node id can not be converted.");
+    }
+    return dimacs_node_id - 1;
+}
+
+// Skips a whitespace separated word starting at or after pos and returns the position after it.
+size_t skip_word(std::string const& line, size_t pos) {
+    pos = line.find_first_not_of(" \t\r", pos);
+    if (pos == std::string::npos) {
+        throw std::runtime_error("Malformed DIMACS line: " + line);
+    }
+    auto const& end = line.find_first_of(" \t\r", pos);
+    return end == std::string::npos ? line.size() : end;
+}
+
+// Parses a number starting at or after pos, stores it in result and returns the position after it.
+size_t parse_number(std::string const& line, size_t pos, size_type& result) {
+    pos = line.find_first_not_of(" \t\r", pos);
+    if (pos == std::string::npos) {
+        throw std::runtime_error("Malformed DIMACS line: " + line);
+    }
+    auto const&[end, error] = std::from_chars(line.data() + pos, line.data() + line.size(), result);
+    if (error != std::errc()) {
+        throw std::runtime_error("Malformed DIMACS line: " + line);
+    }
+    return end - line.data();
+}
+
+} // end of anonymous namespace
+
+DimacsEdgeStream::DimacsEdgeStream(std::istream& input) : _input(input) {
+    read_next_non_comment_line();
+    // Problem line: p edge <num_nodes> <num_edges>
+    auto pos = skip_word(_line, 0);
+    pos = skip_word(_line, pos);
+    pos = parse_number(_line, pos, _num_nodes);
+    parse_number(_line, pos, _num_edges);
+}
+
+std::optional<Edge> DimacsEdgeStream::next_edge() {
+    if (_edges_read == _num_edges) {
+        return std::nullopt;
+    }
+    ++_edges_read;
+    read_next_non_comment_line();
+    // Edge line: e <node1> <node2>
+    size_type dimacs_node1{};
+    size_type dimacs_node2{};
+    auto pos = skip_word(_line, 0);
+    pos = parse_number(_line, pos, dimacs_node1);
+    parse_number(_line, pos, dimacs_node2);
+    auto const& node1 = from_dimacs_id(dimacs_node1);
+    auto const& node2 = from_dimacs_id(dimacs_node2);
+    if (node1 >= _num_nodes or node2 >= _num_nodes) {
+        throw std::runtime_error("DIMACS node id exceeds the number of nodes: " + _line);
+    }
+    return Edge{node1, node2};
+}
+
+void DimacsEdgeStream::read_next_non_comment_line() {
+    do {
+        if (!std::getline(_input, _line)) {
+            throw std::runtime_error("Unexpected end of DIMACS stream.");
+        }
+    } while (_line[0] == 'c');
+}
@@ -0,0 +1,51 @@
+#ifndef MAXMATCHING_DIMACS_EDGE_STREAM_H
+#define MAXMATCHING_DIMACS_EDGE_STREAM_H
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include "graph.h"
+
+/**
+ * Sequential reader for the edges of a DIMACS file. In contrast to Graph::read_dimacs this does not store anything
+ * but the current line, so it can be used to make several passes over graphs that do not fit into memory.
+ */
+class DimacsEdgeStream {
+public:
+    /**
+     * Reads the problem line from the given stream. The stream needs to outlive this object.
+     */
+    explicit DimacsEdgeStream(std::istream& input);
+
+    [[nodiscard]] NodeId num_nodes() const;
+
+    [[nodiscard]] size_type num_edges() const;
+
+    /**
+     * @return The next edge of the stream, using 0-based node ids, or std::nullopt if all edges announced in the
+     * problem line have been read
+     */
+    [[nodiscard]] std::optional<Edge> next_edge();
+
+private:
+    /// Reads the next line that is not a comment into _line
+    void read_next_non_comment_line();
+
+    std::istream& _input;
+    std::string _line;
+    NodeId _num_nodes{};
+    size_type _num_edges{};
+    size_type _edges_read = 0;
+};
+
+//Inline section
+
+inline NodeId DimacsEdgeStream::num_nodes() const {
+    return _num_nodes;
+}
+
+inline size_type DimacsEdgeStream::num_edges() const {
+    return _num_edges;
+}
+
+#endif //MAXMATCHING_DIMACS_EDGE_STREAM_H
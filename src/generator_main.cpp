@@ -0,0 +1,224 @@
+/**
+ * Generates synthetic graphs, either written to a file or solved in memory for scaling studies.
+ *
+ * Usage: maxmatching_gen <family> [--size N] [--seed S] [--average-degree D] [--p P] [--m M] [--degree D]
+ *                        [--exponent E] [--cycle-length K] [--clique-size K] [--out file.dmx] [--snapshot file]
+ *                        [--solve] [--sweep-to N] [--sweep-factor F] [--tree-search dfs|bfs|hybrid]
+ *
+ * Families and the meaning of --size:
+ *   gnp, gnm, regular, power-law: number of nodes
+ *   grid, torus, queen: side length of the square board
+ *   nested-cycles: nesting depth, the graph has cycle-length^size nodes
+ *   odd-cliques: number of cliques
+ *
+ * Without --out, --snapshot or --solve, the graph is written to stdout in DIMACS format. With --sweep-to, the graphs
+ * for size, size * factor, ... up to the given size are generated and solved one after the other, printing one table
+ * row per graph. For the families with a known optimum, the matching size is checked against it.
+ */
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include "graph_generators.h"
+#include "matching_solver.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string family;
+    NodeId size = 1000;
+    unsigned long seed = 0;
+    double average_degree = 4;
+    /// Edge probability for gnp, derived from the average degree if not given
+    std::optional<double> p;
+    /// Number of edges for gnm, derived from the average degree if not given
+    std::optional<size_t> m;
+    NodeId degree = 3;
+    double exponent = 2.5;
+    NodeId cycle_length = 3;
+    NodeId clique_size = 5;
+    std::string dimacs_output;
+    std::string snapshot_output;
+    bool solve = false;
+    NodeId sweep_to = 0;
+    double sweep_factor = 2;
+    SolverConfig solver_config;
+};
+
+Options parse_arguments(int argc, char** argv) {
+    if (argc < 2) {
+        throw std::runtime_error("Expected the graph family");
+    }
+    Options options;
+    options.family = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (arg == "--solve") {
+            options.solve = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + arg);
+        }
+        std::string const value = argv[++i];
+        if (arg == "--size") {
+            options.size = std::stoul(value);
+        } else if (arg == "--seed") {
+            options.seed = std::stoul(value);
+        } else if (arg == "--average-degree") {
+            options.average_degree = std::stod(value);
+        } else if (arg == "--p") {
+            options.p = std::stod(value);
+        } else if (arg == "--m") {
+            options.m = std::stoull(value);
+        } else if (arg == "--degree") {
+            options.degree = std::stoul(value);
+        } else if (arg == "--exponent") {
+            options.exponent = std::stod(value);
+        } else if (arg == "--cycle-length") {
+            options.cycle_length = std::stoul(value);
+        } else if (arg == "--clique-size") {
+            options.clique_size = std::stoul(value);
+        } else if (arg == "--out") {
+            options.dimacs_output = value;
+        } else if (arg == "--snapshot") {
+            options.snapshot_output = value;
+        } else if (arg == "--sweep-to") {
+            options.sweep_to = std::stoul(value);
+        } else if (arg == "--sweep-factor") {
+            options.sweep_factor = std::stod(value);
+        } else if (arg == "--tree-search" and value == "dfs") {
+            options.solver_config.tree_search = TreeSearch::depth_first;
+        } else if (arg == "--tree-search" and value == "bfs") {
+            options.solver_config.tree_search = TreeSearch::breadth_first;
+        } else if (arg == "--tree-search" and value == "hybrid") {
+            options.solver_config.tree_search = TreeSearch::hybrid;
+        } else {
+            throw std::runtime_error("Unexpected argument " + arg + " " + value);
+        }
+    }
+    return options;
+}
+
+CsrGraph generate(Options const& options, NodeId size) {
+    using namespace graph_generators;
+    auto const& family = options.family;
+    auto const& average_degree_edges = static_cast<size_t>(std::llround(options.average_degree * size / 2.));
+    if (family == "gnp") {
+        return gnp(size, options.p ? *options.p : options.average_degree / std::max<double>(size - 1., 1.),
+                   options.seed);
+    } else if (family == "gnm") {
+        return gnm(size, options.m ? *options.m : average_degree_edges, options.seed);
+    } else if (family == "regular") {
+        return random_regular(size, options.degree, options.seed);
+    } else if (family == "grid") {
+        return grid(size, size, false);
+    } else if (family == "torus") {
+        return grid(size, size, true);
+    } else if (family == "queen") {
+        return queen(size);
+    } else if (family == "power-law") {
+        return power_law(size, options.average_degree, options.exponent, options.seed);
+    } else if (family == "nested-cycles") {
+        return nested_odd_cycles(options.cycle_length, size);
+    } else if (family == "odd-cliques") {
+        return odd_cliques(size, options.clique_size);
+    }
+    throw std::runtime_error("Unknown graph family " + family);
+}
+
+/// @return The size of a maximum matching if it is known for the family, which is the case for all non-random ones
+std::optional<size_t> known_optimum(Options const& options, NodeId num_nodes) {
+    auto const& family = options.family;
+    // Grids contain a Hamiltonian path, queen graphs contain the grid, nested cycles are factor-critical and odd
+    // cliques are chained such that all cliques except possibly the last can be matched perfectly in pairs
+    if (family == "grid" or family == "torus" or family == "queen" or family == "nested-cycles"
+        or family == "odd-cliques") {
+        return num_nodes / 2;
+    }
+    return std::nullopt;
+}
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Solves the graph and prints one table row, @return Whether the matching has the known optimal size
+bool solve_and_report(Options const& options, NodeId size, CsrGraph const& graph, double generation_seconds) {
+    MatchingSolver solver;
+    solver.set_config(options.solver_config);
+    auto const& start = Clock::now();
+    solver.solve(graph.view());
+    auto const& solve_seconds = seconds_since(start);
+    auto const& num_nodes = graph.view().num_nodes();
+    auto const& optimum = known_optimum(options, num_nodes);
+    std::cout << size << '\t' << num_nodes << '\t' << graph.num_edges() << '\t' << solver.matching_size() << '\t'
+              << (optimum ? std::to_string(*optimum) : "-") << '\t' << generation_seconds << '\t'
+              << solve_seconds << std::endl;
+    return not optimum or *optimum == solver.matching_size();
+}
+
+void print_table_header() {
+    std::cout << "size\tnodes\tedges\tmatching\toptimum\tgenerate_s\tsolve_s\n";
+}
+
+int run_sweep(Options const& options) {
+    if (options.sweep_factor <= 1) {
+        throw std::runtime_error("Sweep factor needs to be larger than 1");
+    }
+    print_table_header();
+    bool all_optimal = true;
+    for (auto size = options.size; size <= options.sweep_to;) {
+        auto const& start = Clock::now();
+        auto const& graph = generate(options, size);
+        all_optimal &= solve_and_report(options, size, graph, seconds_since(start));
+        // Small sizes (e.g. nesting depths) would not grow with a factor close to 1
+        size = std::max<NodeId>(size + 1, static_cast<NodeId>(std::llround(size * options.sweep_factor)));
+    }
+    return all_optimal ? 0 : 2;
+}
+
+int run_single(Options const& options) {
+    auto const& start = Clock::now();
+    auto const& graph = generate(options, options.size);
+    auto const& generation_seconds = seconds_since(start);
+    if (not options.dimacs_output.empty()) {
+        std::ofstream output(options.dimacs_output);
+        if (not output) {
+            throw std::runtime_error("Failed to open " + options.dimacs_output);
+        }
+        graph_generators::write_dimacs(output, graph.view());
+    }
+    if (not options.snapshot_output.empty()) {
+        std::ofstream output(options.snapshot_output, std::ios::binary);
+        if (not output) {
+            throw std::runtime_error("Failed to open " + options.snapshot_output);
+        }
+        graph.write_snapshot(output);
+    }
+    if (options.solve) {
+        print_table_header();
+        return solve_and_report(options, options.size, graph, generation_seconds) ? 0 : 2;
+    }
+    if (options.dimacs_output.empty() and options.snapshot_output.empty()) {
+        graph_generators::write_dimacs(std::cout, graph.view());
+    }
+    return 0;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto const& options = parse_arguments(argc, argv);
+        return options.sweep_to > 0 ? run_sweep(options) : run_single(options);
+    } catch (std::exception const& xcp) {
+        std::cerr << "Caught exception: " << xcp.what() << '\n';
+        return 1;
+    }
+}
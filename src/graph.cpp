@@ -1,35 +1,11 @@
 #include "graph.h"
+#include "dimacs_edge_stream.h"
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 #include <algorithm>
 #include <cassert>
 #include <optional>
 
-namespace {
-
-// Using a function for converting the DIMACS node ids to and from our node ids
-// makes the in and output code more understandable.
-NodeId from_dimacs_id(size_type dimacs_node_id) {
-    if (dimacs_node_id <= 0) {
-        throw std::runtime_error("Non-positive DIMACS node id can not be converted.");
-    }
-    return dimacs_node_id - 1;
-}
-
-// Returns the first line which is not a comment, i.e. does not start with c.
-std::string read_next_non_comment_line(std::istream& input) {
-    std::string line;
-    do {
-        if (!std::getline(input, line)) {
-            throw std::runtime_error("Unexpected end of DIMACS stream.");
-        }
-    } while (line[0] == 'c');
-    return line;
-}
-
-} // end of anonymous namespace
-
 /////////////////////////////////////////////
 //! \c Node definitions
 /////////////////////////////////////////////
@@ -61,43 +37,17 @@ void Graph::add_edge(NodeId node1_id, NodeId node2_id) {
 }
 
 Graph Graph::read_dimacs(std::istream& input) {
-    // When parsing the DIMACS format, there are some words we are not interested in.
-    // We read them into this variable and never use the afterwards.
-    std::string unused_word{};
-
-    // As we need to watch out for comments, we first need to read the input by line.
-    // In order to split non-comment lines into multiple variables we use a std::stringstream.
-    std::stringstream first_buffering_stream{};
-
-    std::string const first_line = read_next_non_comment_line(input);
-
-    size_type num_nodes{};
-    size_type num_edges{};
-    first_buffering_stream << first_line;
-    first_buffering_stream >> unused_word >> unused_word >> num_nodes >> num_edges;
-
-    // Now we successively add edges to our graph;
-    Graph graph(num_nodes);
-    for (size_type i = 1; i <= num_edges; ++i) {
-        // This works just as parsing the first line!
-        std::stringstream ith_buffering_stream{};
-        std::string const ith_line = read_next_non_comment_line(input);
-        NodeId dimacs_node1{};
-        NodeId dimacs_node2{};
-        ith_buffering_stream << ith_line;
-        ith_buffering_stream >> unused_word >> dimacs_node1 >> dimacs_node2;
-        graph.add_edge(from_dimacs_id(dimacs_node1), from_dimacs_id(dimacs_node2));
+    DimacsEdgeStream edges(input);
+    Graph graph(edges.num_nodes());
+    while (auto const& edge = edges.next_edge()) {
+        graph.add_edge(edge->first, edge->second);
     }
-
     return graph;
 }
 
 Graph Graph::shuffle_with_seed(unsigned long seed) const {
     Graph result(num_nodes());
-    std::vector<NodeId> map(num_nodes());
-    std::iota(map.begin(), map.end(), 0);
-    std::mt19937 random(seed);
-    std::shuffle(map.begin(), map.end(), random);
+    auto const& map = shuffle_map(num_nodes(), seed);
     for (NodeId i = 0; i < num_nodes(); ++i) {
         auto const& mapped = map.at(i);
         for (auto const& neighbor : node(i).neighbors()) {
@@ -113,6 +63,14 @@ Graph Graph::shuffle_with_seed(unsigned long seed) const {
     return result;
 }
 
+std::vector<NodeId> Graph::shuffle_map(NodeId num_nodes, unsigned long seed) {
+    std::vector<NodeId> map(num_nodes);
+    std::iota(map.begin(), map.end(), 0);
+    std::mt19937 random(seed);
+    std::shuffle(map.begin(), map.end(), random);
+    return map;
+}
+
 Graph Graph::with_extra_all_edge_vertices(NodeId extra_vertices) const {
     Graph result = *this;
     result._nodes.resize(num_nodes() + extra_vertices);
@@ -123,3 +81,11 @@ Graph Graph::with_extra_all_edge_vertices(NodeId extra_vertices) const {
     }
     return result;
 }
+
+size_t Graph::memory_bytes() const {
+    size_t result = _nodes.capacity() * sizeof(Node);
+    for (auto const& node : _nodes) {
+        result += node._neighbors.capacity() * sizeof(NodeId);
+    }
+    return result;
+}
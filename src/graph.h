@@ -92,10 +92,22 @@ public:
     **/
     void add_edge(NodeId node1_id, NodeId node2_id);
 
+    /**
+       @brief Renumbers the nodes randomly, node @c i of this graph becomes node @c shuffle_map(num_nodes(), seed)[i].
+    **/
     [[nodiscard]] Graph shuffle_with_seed(unsigned long seed) const;
 
+    /**
+       @return The renumbering used by @c shuffle_with_seed: entry @c i is the new id of node @c i. Its inverse maps
+       results on the shuffled graph back to the original ids.
+    **/
+    [[nodiscard]] static std::vector<NodeId> shuffle_map(NodeId num_nodes, unsigned long seed);
+
     [[nodiscard]] Graph with_extra_all_edge_vertices(NodeId extra_vertices) const;
 
+    /** @return The number of bytes allocated for the nodes and their neighbor arrays. **/
+    [[nodiscard]] size_t memory_bytes() const;
+
     /**
      * Reads a graph in DIMACS format from the given istream and returns that graph.
      */
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include "graph_generators.h"
+
+namespace graph_generators {
+
+namespace {
+
+/// Generators draw from a 64 bit engine, so a seed yields the same graph on every platform
+using RandomEngine = std::mt19937_64;
+
+CsrGraph from_edge_ends(NodeId num_nodes, std::vector<NodeId> const& edge_ends) {
+    CsrGraph result;
+    result.assign_from_edge_list(num_nodes, edge_ends.data(), edge_ends.size() / 2);
+    return result;
+}
+
+/// An edge {a, b} as a single integer, the same for both orientations, so sorting groups parallel edges
+std::uint64_t edge_key(NodeId end_a, NodeId end_b) {
+    return (std::uint64_t(std::min(end_a, end_b)) << 32) | std::max(end_a, end_b);
+}
+
+/// Drops loops and parallel edges from a list of edge keys and returns the remaining edges as edge ends
+std::vector<NodeId> unique_edge_ends(std::vector<std::uint64_t>& keys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::vector<NodeId> edge_ends;
+    edge_ends.reserve(2 * keys.size());
+    for (auto const& key : keys) {
+        auto const& end_a = static_cast<NodeId>(key >> 32);
+        auto const& end_b = static_cast<NodeId>(key);
+        if (end_a != end_b) {
+            edge_ends.push_back(end_a);
+            edge_ends.push_back(end_b);
+        }
+    }
+    return edge_ends;
+}
+
+NodeId checked_num_nodes(std::uint64_t num_nodes) {
+    if (num_nodes >= std::numeric_limits<NodeId>::max()) {
+        throw std::runtime_error("Generated graph exceeds the node id range");
+    }
+    return static_cast<NodeId>(num_nodes);
+}
+
+std::uint64_t max_num_edges(NodeId num_nodes) {
+    return std::uint64_t(num_nodes) * (num_nodes > 0 ? num_nodes - 1 : 0) / 2;
+}
+
+} // end of anonymous namespace
+
+CsrGraph gnp(NodeId num_nodes, double p, unsigned long seed) {
+    std::vector<NodeId> edge_ends;
+    if (p <= 0) {
+        return from_edge_ends(num_nodes, edge_ends);
+    }
+    edge_ends.reserve(2 * static_cast<size_t>(1.05 * std::min(p, 1.) * static_cast<double>(max_num_edges(num_nodes))));
+    if (p >= 1) {
+        for (NodeId i = 0; i < num_nodes; ++i) {
+            for (NodeId j = 0; j < i; ++j) {
+                edge_ends.push_back(i);
+                edge_ends.push_back(j);
+            }
+        }
+        return from_edge_ends(num_nodes, edge_ends);
+    }
+    // Batagelj and Brandes: walk over the pairs (v, w) with w < v in order, skipping geometrically distributed gaps
+    RandomEngine random(seed);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    auto const& log_non_edge = std::log1p(-p);
+    std::uint64_t v = 1;
+    std::uint64_t w = std::numeric_limits<std::uint64_t>::max();
+    while (v < num_nodes) {
+        w += 1 + static_cast<std::uint64_t>(std::floor(std::log1p(-uniform(random)) / log_non_edge));
+        while (w >= v and v < num_nodes) {
+            w -= v;
+            ++v;
+        }
+        if (v < num_nodes) {
+            edge_ends.push_back(static_cast<NodeId>(v));
+            edge_ends.push_back(static_cast<NodeId>(w));
+        }
+    }
+    return from_edge_ends(num_nodes, edge_ends);
+}
+
+CsrGraph gnm(NodeId num_nodes, size_t num_edges, unsigned long seed) {
+    if (num_edges > max_num_edges(num_nodes)) {
+        throw std::runtime_error("More edges requested than a simple graph with this number of nodes has");
+    }
+    RandomEngine random(seed);
+    std::uniform_int_distribution<NodeId> node(0, num_nodes > 0 ? num_nodes - 1 : 0);
+    std::vector<std::uint64_t> keys;
+    keys.reserve(num_edges + num_edges / 8);
+    // Draw as many pairs as edges are missing and drop duplicates, until no edge is missing anymore
+    while (keys.size() < num_edges) {
+        auto const& missing = num_edges - keys.size();
+        for (size_t i = 0; i < missing; ++i) {
+            auto const& end_a = node(random);
+            auto const& end_b = node(random);
+            if (end_a != end_b) {
+                keys.push_back(edge_key(end_a, end_b));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+    return from_edge_ends(num_nodes, unique_edge_ends(keys));
+}
+
+CsrGraph random_regular(NodeId num_nodes, NodeId degree, unsigned long seed) {
+    if ((std::uint64_t(num_nodes) * degree) % 2 != 0) {
+        throw std::runtime_error("A regular graph needs an even number of node degree pairs");
+    }
+    if (num_nodes > 0 and degree >= num_nodes) {
+        throw std::runtime_error("Degree of a regular graph needs to be smaller than the number of nodes");
+    }
+    // Pairing model: one point per edge end, a random perfect matching of the points gives the edges
+    std::vector<NodeId> points(size_t(num_nodes) * degree);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points.at(i) = static_cast<NodeId>(i / degree);
+    }
+    RandomEngine random(seed);
+    std::shuffle(points.begin(), points.end(), random);
+    std::vector<std::uint64_t> keys;
+    keys.reserve(points.size() / 2);
+    for (size_t i = 0; i + 1 < points.size(); i += 2) {
+        keys.push_back(edge_key(points.at(i), points.at(i + 1)));
+    }
+    points = {};
+    return from_edge_ends(num_nodes, unique_edge_ends(keys));
+}
+
+CsrGraph grid(NodeId rows, NodeId cols, bool torus) {
+    auto const& num_nodes = checked_num_nodes(std::uint64_t(rows) * cols);
+    std::vector<NodeId> edge_ends;
+    edge_ends.reserve(4 * size_t(num_nodes));
+    auto const& add_edge = [&](NodeId end_a, NodeId end_b) {
+        edge_ends.push_back(end_a);
+        edge_ends.push_back(end_b);
+    };
+    for (NodeId r = 0; r < rows; ++r) {
+        for (NodeId c = 0; c < cols; ++c) {
+            auto const& id = r * cols + c;
+            if (c + 1 < cols) {
+                add_edge(id, id + 1);
+            }
+            if (r + 1 < rows) {
+                add_edge(id, id + cols);
+            }
+        }
+    }
+    // Wrapping around a dimension with 2 nodes would duplicate the existing edge, with 1 node it would be a loop
+    if (torus and cols > 2) {
+        for (NodeId r = 0; r < rows; ++r) {
+            add_edge(r * cols, r * cols + cols - 1);
+        }
+    }
+    if (torus and rows > 2) {
+        for (NodeId c = 0; c < cols; ++c) {
+            add_edge(c, (rows - 1) * cols + c);
+        }
+    }
+    return from_edge_ends(num_nodes, edge_ends);
+}
+
+CsrGraph queen(NodeId side) {
+    auto const& num_nodes = checked_num_nodes(std::uint64_t(side) * side);
+    std::vector<NodeId> edge_ends;
+    // Each square sees at most 4 * (side - 1) others, every edge is generated once from its smaller end
+    edge_ends.reserve(size_t(num_nodes) * 4 * (side > 0 ? side - 1 : 0));
+    for (NodeId r = 0; r < side; ++r) {
+        for (NodeId c = 0; c < side; ++c) {
+            auto const& id = r * side + c;
+            // Moves to the right, down, down right and down left
+            for (NodeId other_c = c + 1; other_c < side; ++other_c) {
+                edge_ends.push_back(id);
+                edge_ends.push_back(r * side + other_c);
+            }
+            for (NodeId other_r = r + 1; other_r < side; ++other_r) {
+                auto const& distance = other_r - r;
+                edge_ends.push_back(id);
+                edge_ends.push_back(other_r * side + c);
+                if (c + distance < side) {
+                    edge_ends.push_back(id);
+                    edge_ends.push_back(other_r * side + c + distance);
+                }
+                if (c >= distance) {
+                    edge_ends.push_back(id);
+                    edge_ends.push_back(other_r * side + c - distance);
+                }
+            }
+        }
+    }
+    return from_edge_ends(num_nodes, edge_ends);
+}
+
+CsrGraph power_law(NodeId num_nodes, double average_degree, double exponent, unsigned long seed) {
+    if (exponent <= 2) {
+        throw std::runtime_error("Power law exponent needs to be larger than 2");
+    }
+    // Node i gets weight proportional to (i + 1)^-alpha, which gives a degree distribution with the given exponent.
+    // Ends are sampled in constant time by inverting the continuous approximation of the cumulative weights, which is
+    // proportional to x^(1 - alpha).
+    auto const& alpha = 1. / (exponent - 1.);
+    auto const& inverse_power = 1. / (1. - alpha);
+    auto const& num_draws = static_cast<size_t>(std::llround(average_degree * num_nodes / 2.));
+    RandomEngine random(seed);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    auto const& draw_node = [&]() {
+        auto const& position = static_cast<double>(num_nodes) * std::pow(uniform(random), inverse_power);
+        return std::min(static_cast<NodeId>(position), num_nodes - 1);
+    };
+    std::vector<std::uint64_t> keys;
+    keys.reserve(num_nodes > 0 ? num_draws : 0);
+    for (size_t i = 0; i < num_draws and num_nodes > 0; ++i) {
+        auto const& end_a = draw_node();
+        keys.push_back(edge_key(end_a, draw_node()));
+    }
+    return from_edge_ends(num_nodes, unique_edge_ends(keys));
+}
+
+CsrGraph nested_odd_cycles(NodeId cycle_length, NodeId depth) {
+    if (cycle_length < 3 or cycle_length % 2 == 0) {
+        throw std::runtime_error("Nested cycles need an odd cycle length of at least 3");
+    }
+    std::uint64_t num_nodes = 1;
+    for (NodeId level = 0; level < depth; ++level) {
+        num_nodes = checked_num_nodes(num_nodes * cycle_length);
+    }
+    std::vector<NodeId> edge_ends;
+    // Level l has num_nodes / cycle_length^(l - 1) edges, so the total is less than num_nodes * 1.5
+    edge_ends.reserve(3 * num_nodes);
+    std::uint64_t block_size = 1;
+    for (NodeId level = 0; level < depth; ++level) {
+        auto const& group_size = block_size * cycle_length;
+        for (std::uint64_t group_start = 0; group_start < num_nodes; group_start += group_size) {
+            for (NodeId j = 0; j < cycle_length; ++j) {
+                edge_ends.push_back(static_cast<NodeId>(group_start + j * block_size));
+                edge_ends.push_back(static_cast<NodeId>(group_start + ((j + 1) % cycle_length) * block_size));
+            }
+        }
+        block_size = group_size;
+    }
+    return from_edge_ends(static_cast<NodeId>(num_nodes), edge_ends);
+}
+
+CsrGraph odd_cliques(NodeId num_cliques, NodeId clique_size) {
+    if (clique_size < 3 or clique_size % 2 == 0) {
+        throw std::runtime_error("Clique size needs to be odd and at least 3");
+    }
+    auto const& num_nodes = checked_num_nodes(std::uint64_t(num_cliques) * clique_size);
+    std::vector<NodeId> edge_ends;
+    edge_ends.reserve(2 * (max_num_edges(clique_size) * num_cliques + num_cliques));
+    for (NodeId clique = 0; clique < num_cliques; ++clique) {
+        auto const& first = clique * clique_size;
+        for (NodeId i = 0; i < clique_size; ++i) {
+            for (NodeId j = i + 1; j < clique_size; ++j) {
+                edge_ends.push_back(first + i);
+                edge_ends.push_back(first + j);
+            }
+        }
+        if (clique + 1 < num_cliques) {
+            edge_ends.push_back(first);
+            edge_ends.push_back(first + clique_size + 1);
+        }
+    }
+    return from_edge_ends(num_nodes, edge_ends);
+}
+
+void write_dimacs(std::ostream& output, CsrGraphView const& graph) {
+    size_t num_edges = 0;
+    for (NodeId i = 0; i < graph.num_nodes(); ++i) {
+        num_edges += graph.node(i).degree();
+    }
+    output << "p edge " << graph.num_nodes() << ' ' << num_edges / 2 << '\n';
+    for (NodeId i = 0; i < graph.num_nodes(); ++i) {
+        for (auto const& neighbor : graph.node(i).neighbors()) {
+            if (i < neighbor) {
+                output << "e " << i + 1 << ' ' << neighbor + 1 << '\n';
+            }
+        }
+    }
+}
+
+} // namespace graph_generators
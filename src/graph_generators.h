@@ -0,0 +1,63 @@
+#ifndef MAXMATCHING_GRAPH_GENERATORS_H
+#define MAXMATCHING_GRAPH_GENERATORS_H
+
+#include <iosfwd>
+#include "csr_graph.h"
+
+/**
+ * Seeded, reproducible synthetic graphs for scaling studies. All generators build the CSR arrays directly from a flat
+ * edge array, so graphs with 10^8 edges fit into memory without a detour through Graph or DIMACS files. The same
+ * seed always produces the same graph. Unless noted otherwise, the graphs are simple.
+ */
+namespace graph_generators {
+
+/**
+ * Erdős–Rényi graph: Each of the n(n - 1)/2 possible edges exists independently with probability p. Runs in
+ * O(n + m) by skipping geometrically distributed numbers of non-edges.
+ */
+CsrGraph gnp(NodeId num_nodes, double p, unsigned long seed);
+
+/// A uniformly random simple graph with exactly num_edges edges
+CsrGraph gnm(NodeId num_nodes, size_t num_edges, unsigned long seed);
+
+/**
+ * Random graph from the pairing model with all degrees equal to degree, except that loops and parallel edges are
+ * dropped, so a few nodes end up with a smaller degree. num_nodes * degree needs to be even.
+ */
+CsrGraph random_regular(NodeId num_nodes, NodeId degree, unsigned long seed);
+
+/// rows x cols grid, node (r, c) has id r * cols + c. A torus additionally wraps around in both directions.
+CsrGraph grid(NodeId rows, NodeId cols, bool torus);
+
+/// Queen graph of a side x side chess board: Two squares are adjacent if a queen can move from one to the other
+CsrGraph queen(NodeId side);
+
+/**
+ * Chung-Lu graph with expected degrees following a power law with the given exponent (> 2), so P(degree = k) is
+ * proportional to k^-exponent: The ends of num_nodes * average_degree / 2 edges are drawn with probability
+ * proportional to the node weights. Loops and parallel edges are dropped, so the actual average degree is slightly
+ * smaller.
+ */
+CsrGraph power_law(NodeId num_nodes, double average_degree, double exponent, unsigned long seed);
+
+/**
+ * cycle_length^depth nodes forming odd cycles nested into each other: On the lowest level, consecutive groups of
+ * cycle_length nodes form a cycle. On each further level, cycle_length consecutive blocks of the level below are
+ * connected to a cycle by edges between their first nodes. Every level is factor-critical, so the maximum matching
+ * leaves exactly one node exposed, but finding it requires blossoms nested depth levels deep.
+ * @param cycle_length Odd, at least 3
+ */
+CsrGraph nested_odd_cycles(NodeId cycle_length, NodeId depth);
+
+/**
+ * num_cliques cliques with clique_size nodes each (odd), where node 0 of each clique is connected to node 1 of the
+ * next one. The maximum matching covers all nodes except one if the total number of nodes is odd.
+ */
+CsrGraph odd_cliques(NodeId num_cliques, NodeId clique_size);
+
+/// Writes the graph in DIMACS format, every edge {u, v} with u < v once per occurrence
+void write_dimacs(std::ostream& output, CsrGraphView const& graph);
+
+} // namespace graph_generators
+
+#endif //MAXMATCHING_GRAPH_GENERATORS_H
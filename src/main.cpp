@@ -1,43 +1,426 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <sys/resource.h>
 #include "graph.h"
-#include "maximum_matching_algorithm.h"
+#include "matching_solver.h"
+#include "compressed_graph.h"
+#include "semi_streaming_matching.h"
+#include "solver_daemon.h"
+#include "perf_counters.h"
+#include "portfolio_solver.h"
+#include "trace.h"
 
-int main(int argc, char** argv) {
-    if (argc != 2) {
-        std::cerr << "Expected exactly one arg\n";
-        return 1;
+namespace {
+
+enum class Layout {
+    vector,
+    compressed,
+};
+
+struct Options {
+    std::string input_file;
+    bool semi_streaming = false;
+    SemiStreamingMatching::Config streaming_config;
+    /// Socket path if running as a daemon
+    std::string daemon_socket;
+    size_t daemon_workers = std::max(1u, std::thread::hardware_concurrency());
+    /// Graphs loaded by the daemon before accepting connections, as name and file
+    std::vector<std::pair<std::string, std::string>> preloaded_graphs;
+    std::string snapshot_output;
+    Layout layout = Layout::vector;
+    /// Neighbor entries buffered per pass when building the compressed layout
+    size_t compression_buffer_entries = size_t(1) << 26;
+    /// Report memory use and timings of the graph layout on stderr
+    bool layout_report = false;
+    SolverConfig solver_config;
+    /// Report counters of the matching algorithm on stderr
+    bool solver_stats = false;
+    /// File to write the statistics report to as JSON
+    std::string stats_json;
+    /// File to write a Chrome trace of the solver phases to
+    std::string trace_output;
+    /// Record every n-th tree in the trace
+    unsigned trace_sample_every = 64;
+    size_t trace_buffer_events = size_t(1) << 20;
+    /// Count hardware events per phase, reported with the solver statistics
+    bool perf_counters = false;
+    /// Number of solver instances racing on differently shuffled copies of the graph, 1 to run a single solver
+    size_t portfolio_size = 1;
+    /// Seconds the solver may run before returning the matching found so far
+    std::optional<double> time_limit;
+    /// Seconds between progress reports on stderr
+    std::optional<double> progress_interval;
+    /// File the solver state is written to periodically, see SolverCheckpoint
+    std::string checkpoint_file;
+    double checkpoint_interval = 60;
+    /// Continue from checkpoint_file if it exists
+    bool resume = false;
+};
+
+double parse_seconds(std::string const& flag, char const* value) {
+    try {
+        return std::stod(value);
+    } catch (std::exception const&) {
+        throw std::runtime_error("Expected a number of seconds after " + flag);
     }
+}
+
+size_t parse_count(std::string const& flag, char const* value) {
     try {
-        // Debug output: Do not dump the (potentially massive) matching edge list, log time for parsing vs solving
-        // instead
-#ifdef DEBUG_OUTPUT
-        auto const& parsing_start = std::chrono::system_clock::now();
+        return std::stoull(value);
+    } catch (std::exception const&) {
+        throw std::runtime_error("Expected a number after " + flag);
+    }
+}
+
+Options parse_arguments(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        auto const& next_string = [&]() {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            return std::string(argv[++i]);
+        };
+        auto const& next_value = [&]() {
+            return parse_count(arg, next_string().c_str());
+        };
+        if (arg == "--semi-streaming") {
+            options.semi_streaming = true;
+        } else if (arg == "--stream-buffer-kb") {
+            options.streaming_config.buffer_bytes = next_value() * 1024;
+        } else if (arg == "--stream-candidates") {
+            options.streaming_config.candidates_per_vertex = next_value();
+        } else if (arg == "--max-passes") {
+            options.streaming_config.max_passes = next_value();
+        } else if (arg == "--daemon") {
+            options.daemon_socket = next_string();
+        } else if (arg == "--workers") {
+            options.daemon_workers = next_value();
+        } else if (arg == "--preload") {
+            auto const& spec = next_string();
+            auto const& separator = spec.find('=');
+            if (separator == std::string::npos) {
+                throw std::runtime_error("Expected name=file after --preload");
+            }
+            options.preloaded_graphs.emplace_back(spec.substr(0, separator), spec.substr(separator + 1));
+        } else if (arg == "--layout") {
+            auto const& layout = next_string();
+            if (layout == "vector") {
+                options.layout = Layout::vector;
+            } else if (layout == "compressed") {
+                options.layout = Layout::compressed;
+            } else {
+                throw std::runtime_error("Unknown layout " + layout);
+            }
+        } else if (arg == "--compression-buffer-mb") {
+            options.compression_buffer_entries = next_value() * (1 << 20) / sizeof(NodeId);
+        } else if (arg == "--layout-report") {
+            options.layout_report = true;
+        } else if (arg == "--root-order") {
+            auto const& order = next_string();
+            if (order == "id") {
+                options.solver_config.root_order = RootOrder::by_id;
+            } else if (order == "min-degree") {
+                options.solver_config.root_order = RootOrder::min_degree;
+            } else if (order == "max-degree") {
+                options.solver_config.root_order = RootOrder::max_degree;
+            } else if (order == "random") {
+                options.solver_config.root_order = RootOrder::random;
+            } else {
+                throw std::runtime_error("Unknown root order " + order);
+            }
+        } else if (arg == "--tree-search") {
+            auto const& order = next_string();
+            if (order == "dfs") {
+                options.solver_config.tree_search = TreeSearch::depth_first;
+            } else if (order == "bfs") {
+                options.solver_config.tree_search = TreeSearch::breadth_first;
+            } else if (order == "hybrid") {
+                options.solver_config.tree_search = TreeSearch::hybrid;
+            } else {
+                throw std::runtime_error("Unknown tree search order " + order);
+            }
+        } else if (arg == "--seed") {
+            options.solver_config.seed = next_value();
+        } else if (arg == "--solver-stats") {
+            options.solver_stats = true;
+        } else if (arg == "--stats-json") {
+            options.stats_json = next_string();
+        } else if (arg == "--perf-counters") {
+            options.perf_counters = true;
+        } else if (arg == "--trace") {
+            options.trace_output = next_string();
+        } else if (arg == "--trace-sample") {
+            options.trace_sample_every = next_value();
+        } else if (arg == "--trace-buffer-events") {
+            options.trace_buffer_events = next_value();
+        } else if (arg == "--time-limit") {
+            options.time_limit = parse_seconds(arg, next_string().c_str());
+        } else if (arg == "--progress") {
+            options.progress_interval = parse_seconds(arg, next_string().c_str());
+        } else if (arg == "--checkpoint") {
+            options.checkpoint_file = next_string();
+        } else if (arg == "--checkpoint-interval") {
+            options.checkpoint_interval = parse_seconds(arg, next_string().c_str());
+        } else if (arg == "--resume") {
+            options.resume = true;
+        } else if (arg == "--portfolio") {
+            options.portfolio_size = std::max<size_t>(next_value(), 1);
+        } else if (arg == "--write-snapshot") {
+            options.snapshot_output = next_string();
+        } else if (options.input_file.empty() and arg.rfind("--", 0) != 0) {
+            options.input_file = arg;
+        } else {
+            throw std::runtime_error("Unexpected argument " + arg);
+        }
+    }
+    if (options.input_file.empty() and options.daemon_socket.empty()) {
+        throw std::runtime_error("Expected an input file");
+    }
+    if (options.portfolio_size > 1 and (options.time_limit or options.progress_interval)) {
+        throw std::runtime_error("--time-limit and --progress are not supported with --portfolio");
+    }
+    if (options.portfolio_size > 1 and not options.checkpoint_file.empty()) {
+        throw std::runtime_error("--checkpoint is not supported with --portfolio");
+    }
+    if (options.resume and options.checkpoint_file.empty()) {
+        throw std::runtime_error("--resume needs the file given by --checkpoint");
+    }
+    return options;
+}
+
+void print_matching(NodeId num_nodes, EdgeList const& matching_edges) {
+    trace::Scope scope("write_output");
+    perf_counters::PhaseScope phase(perf_counters::Phase::output);
+    std::cout << "p edge " << num_nodes << " " << matching_edges.size() << '\n';
+#ifndef DEBUG_OUTPUT
+    for (auto const&[end_a, end_b] : matching_edges) {
+        std::cout << "e " << (end_a + 1) << ' ' << (end_b + 1) << '\n';
+    }
 #endif
-        std::ifstream input(argv[1]);
-        auto const g = Graph::read_dimacs(input);
+    std::cout << std::flush;
+}
+
+void run_semi_streaming(Options const& options) {
+    SemiStreamingMatching solver(options.input_file, options.streaming_config);
+    auto const& matching_edges = solver.calc_matching();
+    auto const& report = solver.report();
+    // The report goes to stderr to keep stdout a valid DIMACS matching
+    std::cerr << "Semi-streaming passes: " << report.passes << '\n'
+              << "Matching size: " << report.matching_size << ", maximum matching size at most "
+              << report.upper_bound << '\n'
+              << "Approximation ratio: at least " << report.approximation_ratio()
+              << (report.no_short_augmenting_paths ? " (no augmenting paths of length 3 left)\n" : "\n");
+    print_matching(solver.num_nodes(), matching_edges);
+}
+
+void run_daemon(Options const& options) {
+    SolverDaemon daemon(options.daemon_socket, options.daemon_workers);
+    for (auto const&[name, file] : options.preloaded_graphs) {
+        auto const& num_nodes = daemon.load_graph(name, file);
+        std::cerr << "Loaded " << name << " with " << num_nodes << " nodes\n";
+    }
+    daemon.run();
+}
+
+void write_snapshot(Options const& options) {
+    std::ifstream input(options.input_file);
+    CsrGraph graph;
+    graph.assign_from_graph(Graph::read_dimacs(input));
+    std::ofstream output(options.snapshot_output, std::ios::binary);
+    graph.write_snapshot(output);
+}
+
+std::string json_string(std::string const& value) {
+    std::string result = "\"";
+    for (auto const& c : value) {
+        if (c == '"' or c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + '"';
+}
+
+void write_stats_json(Options const& options, NodeId num_nodes, size_t matching_size,
+                      SolverStatistics const& statistics) {
+    std::ofstream output(options.stats_json);
+    if (not output) {
+        throw std::runtime_error("Failed to open " + options.stats_json);
+    }
+    output << "{\n"
+           << "  \"instance\": " << json_string(options.input_file) << ",\n"
+           << "  \"num_nodes\": " << num_nodes << ",\n"
+           << "  \"matching_size\": " << matching_size << ",\n"
+           << "  \"solver\": ";
+    statistics.write_json(output);
+    if (options.perf_counters) {
+        output << ",\n  \"perf_counters\": ";
+        perf_counters::write_json(output);
+    }
+    output << "\n}\n";
+}
+
+size_t peak_rss_kb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void print_progress(SolverProgress const& progress) {
+    std::cerr << "Progress after " << progress.seconds << " s: matching size " << progress.matching_size
+              << ", at most " << progress.upper_bound << ", " << progress.edges_per_second << " edges/s\n";
+}
+
+void write_trace(Options const& options) {
+    std::ofstream output(options.trace_output);
+    if (not output) {
+        throw std::runtime_error("Failed to open " + options.trace_output);
+    }
+    trace::write_chrome_json(output);
+}
+
+void run_solver(Options const& options) {
+    if (not options.trace_output.empty()) {
+        trace::enable(options.trace_buffer_events, options.trace_sample_every);
+    }
+    if (options.perf_counters and not perf_counters::enable()) {
+        std::cerr << "Performance counters unavailable: " << perf_counters::error() << '\n';
+    }
+    auto const& parsing_start = std::chrono::system_clock::now();
+    std::optional<Graph> vector_graph;
+    std::optional<CompressedGraph> compressed_graph;
+    {
+        trace::Scope scope("parse");
+        perf_counters::PhaseScope phase(perf_counters::Phase::parse);
+        if (options.layout == Layout::compressed) {
+            compressed_graph = CompressedGraph::read_dimacs(options.input_file, options.compression_buffer_entries);
+        } else {
+            std::ifstream input(options.input_file);
+            vector_graph = Graph::read_dimacs(input);
+        }
+    }
+    auto const& parsing_done = std::chrono::system_clock::now();
+    auto const& parsing = std::chrono::duration_cast<std::chrono::milliseconds>(parsing_done - parsing_start);
+    // Debug output: Do not dump the (potentially massive) matching edge list, log time for parsing vs solving
+    // instead
 #ifdef DEBUG_OUTPUT
-        std::cout << "Parsing done\n";
-        auto const& parsing_done = std::chrono::system_clock::now();
-        auto const& parsing = std::chrono::duration_cast<std::chrono::milliseconds>(parsing_done - parsing_start);
-        std::cout << "Parsing time: " << parsing.count() / 1e3 << " s\n";
+    std::cout << "Parsing done\n";
+    std::cout << "Parsing time: " << parsing.count() / 1e3 << " s\n";
 #endif
-        auto const& num_nodes = g.num_nodes();
-        MaximumMatchingAlgorithm solver(std::move(g));
-        auto const& matching_edges = solver.calc_maximum_matching();
+    auto const& num_nodes = compressed_graph ? compressed_graph->num_nodes() : vector_graph->num_nodes();
+    size_t matching_size;
+    EdgeList matching_edges;
+    SolverStatistics statistics;
+    {
+        trace::Scope scope("solve");
+        if (options.portfolio_size > 1) {
+            PortfolioSolver portfolio(PortfolioSolver::default_members(options.portfolio_size,
+                                                                       options.solver_config));
+            auto const& result = compressed_graph ? portfolio.solve(*compressed_graph)
+                                                  : portfolio.solve(*vector_graph);
+            if (options.solver_stats) {
+                std::cerr << "Portfolio winner: member " << result.winner << " of " << options.portfolio_size
+                          << " after " << result.seconds << " s\n";
+            }
+            matching_edges = result.matching_edges();
+            matching_size = result.matching_size;
+            statistics = result.statistics;
+        } else {
+            MatchingSolver solver;
+            solver.set_config(options.solver_config);
+            CancellationToken deadline;
+            if (options.time_limit) {
+                deadline.set_deadline(CancellationToken::Clock::now() + std::chrono::duration_cast<
+                        CancellationToken::Clock::duration>(std::chrono::duration<double>(*options.time_limit)));
+                solver.set_cancellation_token(&deadline);
+            }
+            if (options.progress_interval) {
+                solver.set_progress_callback(print_progress, *options.progress_interval);
+            }
+            if (not options.checkpoint_file.empty()) {
+                solver.set_checkpoint_file(options.checkpoint_file, options.checkpoint_interval);
+                std::ifstream checkpoint_input(options.checkpoint_file, std::ios::binary);
+                if (options.resume and checkpoint_input) {
+                    // A missing file means the previous run did not get to its first checkpoint: Start from scratch
+                    auto checkpoint = SolverCheckpoint::read(checkpoint_input);
+                    std::cerr << "Resuming from " << options.checkpoint_file << ": matching size "
+                              << (checkpoint.mates.size() - std::count(checkpoint.mates.begin(),
+                                                                       checkpoint.mates.end(),
+                                                                       SolverCheckpoint::unmatched)) / 2 << '\n';
+                    solver.resume_from(std::move(checkpoint));
+                }
+            }
+            if (compressed_graph) {
+                solver.solve(*compressed_graph);
+            } else {
+                solver.solve(*vector_graph);
+            }
+            matching_size = solver.matching_size();
+            matching_edges = solver.matching_edges();
+            statistics = solver.statistics();
+            if (solver.was_cancelled()) {
+                std::cerr << "Time limit reached: matching size " << matching_size
+                          << ", maximum matching size at most " << solver.matching_upper_bound() << '\n';
+            }
+        }
+    }
+    auto const& end = std::chrono::system_clock::now();
+    auto const& matching = std::chrono::duration_cast<std::chrono::milliseconds>(end - parsing_done);
 #ifdef DEBUG_OUTPUT
-        auto const& end = std::chrono::system_clock::now();
-        auto const& matching = std::chrono::duration_cast<std::chrono::milliseconds>(end - parsing_done);
-        std::cout << "Matching time: " << matching.count() / 1e3 << " s\n";
+    std::cout << "Matching time: " << matching.count() / 1e3 << " s\n";
 #endif
-        std::cout << "p edge " << num_nodes << " " << matching_edges.size() << '\n';
-#ifndef DEBUG_OUTPUT
-        for (auto const&[end_a, end_b] : matching_edges) {
-            std::cout << "e " << (end_a + 1) << ' ' << (end_b + 1) << '\n';
+    if (options.layout_report) {
+        std::cerr << "Layout: " << (compressed_graph ? "compressed" : "vector") << '\n'
+                  << "Graph memory: " << (compressed_graph ? compressed_graph->memory_bytes()
+                                                           : vector_graph->memory_bytes()) << " bytes\n";
+        if (compressed_graph) {
+            std::cerr << "Passes over the input: " << compressed_graph->num_passes() << '\n';
         }
-#endif
-        std::cout << std::flush;
+        std::cerr << "Parsing time: " << parsing.count() / 1e3 << " s\n"
+                  << "Matching time: " << matching.count() / 1e3 << " s\n"
+                  << "Peak RSS: " << peak_rss_kb() << " KiB\n";
+    }
+    statistics.parse_seconds = std::chrono::duration<double>(parsing_done - parsing_start).count();
+    print_matching(num_nodes, matching_edges);
+    if (options.solver_stats) {
+        statistics.print(std::cerr);
+        if (options.perf_counters) {
+            perf_counters::print(std::cerr);
+        }
+    }
+    if (not options.stats_json.empty()) {
+        write_stats_json(options, num_nodes, matching_size, statistics);
+    }
+    if (not options.trace_output.empty()) {
+        write_trace(options);
+    }
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto const& options = parse_arguments(argc, argv);
+        if (options.semi_streaming) {
+            run_semi_streaming(options);
+            return 0;
+        } else if (not options.daemon_socket.empty()) {
+            run_daemon(options);
+            return 0;
+        } else if (not options.snapshot_output.empty()) {
+            write_snapshot(options);
+            return 0;
+        }
+        run_solver(options);
     } catch (std::exception const& xcp) {
         std::cerr << "Caught exception: " << xcp.what() << '\n';
         return 1;
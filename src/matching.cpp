@@ -29,9 +29,25 @@ void Matching::add_edge(NodeId end_a, NodeId end_b) {
     _matched_vertices.at(repr_b) = repr_a;
     _real_vertex_used_for.at(repr_a) = end_a;
     _real_vertex_used_for.at(repr_b) = end_b;
+    ++_size;
     validate();
 }
 
+void Matching::remove_edge(NodeId end_a, NodeId end_b) {
+    assert(_shrink_data.empty());
+    Representative repr_a(end_a);
+    Representative repr_b(end_b);
+    assert(contains_edge(repr_a, repr_b));
+    _matched_vertices.at(repr_a) = repr_a;
+    _matched_vertices.at(repr_b) = repr_b;
+    --_size;
+    validate();
+}
+
+void Matching::set_statistics(SolverStatistics* statistics) {
+    _statistics = statistics;
+}
+
 void Matching::augment_along(
         std::vector<Representative> const& path, std::vector<std::pair<NodeId, NodeId>> const& edges
 ) {
@@ -56,6 +72,12 @@ void Matching::augment_along(
         _real_vertex_used_for.at(new_end) = edge.first;
         _real_vertex_used_for.at(fixed_end) = edge.second;
     }
+#ifdef MAXMATCHING_STATISTICS
+    if (_statistics) {
+        _statistics->record_augmenting_path(edges.size());
+    }
+#endif
+    ++_size;
     validate();
 }
 
@@ -146,6 +168,10 @@ size_t Matching::total_num_nodes() const {
     return _matched_vertices.size();
 }
 
+size_t Matching::size() const {
+    return _size;
+}
+
 void Matching::validate([[maybe_unused]]NestedShrinking const* shrinking) const {
 #ifndef NDEBUG
     for (NodeId i = 0; i < total_num_nodes(); ++i) {
@@ -173,5 +199,6 @@ EdgeList Matching::get_matching_edges() const {
             }
         }
     }
+    assert(matching_edges.size() == _size);
     return matching_edges;
 }
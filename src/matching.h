@@ -7,17 +7,23 @@
 #include "graph.h"
 #include "nested_shrinking.h"
 #include "representative_vector.h"
+#include "solver_statistics.h"
 
 class Matching {
 public:
     explicit Matching(NodeId total_nodes);
 
+    /// Augmenting paths are recorded in the given statistics from now on, nullptr to stop recording
+    void set_statistics(SolverStatistics* statistics);
+
     [[nodiscard]] bool is_matched(Representative name) const;
 
     [[nodiscard]] bool contains_edge(Representative end_a, Representative end_b) const;
 
     void add_edge(NodeId end_a, NodeId end_b);
 
+    void remove_edge(NodeId end_a, NodeId end_b);
+
     void augment_along(std::vector<Representative> const& path, std::vector<std::pair<NodeId, NodeId>> const& edges);
 
     /**
@@ -45,6 +51,9 @@ public:
 
     [[nodiscard]] size_t total_num_nodes() const;
 
+    /// @return The number of matching edges, including those inside shrunken circuits
+    [[nodiscard]] size_t size() const;
+
     [[nodiscard]] EdgeList get_matching_edges() const;
 
 private:
@@ -60,6 +69,8 @@ private:
     /// Acts as a stack storing the data needed to undo shrinking operations in addition to the data stored elsewhere
     /// In this case the data is the actual edges used in the circuit
     std::vector<EdgeList> _shrink_data;
+    size_t _size = 0;
+    SolverStatistics* _statistics = nullptr;
 };
 
 
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <stdexcept>
+#include "matching_solver.h"
+#include "maximum_matching_algorithm.h"
+
+namespace {
+
+// Converts a mate array to the list of matching edges, checking that it actually describes a matching of the graph
+EdgeList edges_from_mates(CsrGraphView const& graph, std::vector<NodeId> const& mates) {
+    if (mates.size() != graph.num_nodes()) {
+        throw std::runtime_error("Mate array size does not match the number of nodes");
+    }
+    EdgeList result;
+    for (NodeId i = 0; i < mates.size(); ++i) {
+        auto const& mate = mates.at(i);
+        if (mate == MatchingSolver::unmatched or mate < i) {
+            continue;
+        }
+        if (mate >= mates.size() or mates.at(mate) != i) {
+            throw std::runtime_error("Mate array is not symmetric");
+        }
+        auto const& neighbors = graph.node(i).neighbors();
+        if (std::find(neighbors.begin(), neighbors.end(), mate) == neighbors.end()) {
+            throw std::runtime_error("Mate array contains a non-edge");
+        }
+        result.emplace_back(i, mate);
+    }
+    return result;
+}
+
+} // end of anonymous namespace
+
+std::vector<NodeId> const& MatchingSolver::solve(CsrGraphView const& graph) {
+    return solve_impl(graph);
+}
+
+std::vector<NodeId> const& MatchingSolver::solve(Graph const& graph) {
+    return solve_impl(graph);
+}
+
+std::vector<NodeId> const& MatchingSolver::solve(CompressedGraph const& graph) {
+    return solve_impl(graph);
+}
+
+std::vector<NodeId> const& MatchingSolver::solve_edge_list(
+        NodeId num_nodes, NodeId const* edge_ends, size_t num_edges
+) {
+    _edge_list_graph.assign_from_edge_list(num_nodes, edge_ends, num_edges);
+    return solve_impl(_edge_list_graph.view());
+}
+
+std::vector<NodeId> const& MatchingSolver::solve_subgraph(
+        CsrGraphView const& graph, std::vector<char> const& vertex_mask
+) {
+    if (vertex_mask.size() != graph.num_nodes()) {
+        throw std::runtime_error("Vertex mask size does not match the number of nodes");
+    }
+    return solve_impl(graph, &vertex_mask);
+}
+
+std::vector<NodeId> const& MatchingSolver::solve_warm_start(
+        CsrGraphView const& graph, std::vector<NodeId> const& initial_mates
+) {
+    auto const& initial_matching = edges_from_mates(graph, initial_mates);
+    return solve_impl(graph, nullptr, &initial_matching);
+}
+
+void MatchingSolver::set_config(SolverConfig const& config) {
+    _config = config;
+}
+
+void MatchingSolver::set_cancellation_token(CancellationToken const* cancellation) {
+    _cancellation = cancellation;
+}
+
+void MatchingSolver::set_progress_callback(ProgressCallback callback, double interval_seconds) {
+    _progress_callback = std::move(callback);
+    _progress_interval_seconds = interval_seconds;
+}
+
+void MatchingSolver::set_checkpoint_file(std::string file_name, double interval_seconds) {
+    _checkpoint_file = std::move(file_name);
+    _checkpoint_interval_seconds = interval_seconds;
+}
+
+void MatchingSolver::resume_from(SolverCheckpoint checkpoint) {
+    _resume_checkpoint = std::move(checkpoint);
+}
+
+std::vector<NodeId> const& MatchingSolver::mates() const {
+    return _mates;
+}
+
+size_t MatchingSolver::matching_size() const {
+    return _matching_size;
+}
+
+EdgeList MatchingSolver::matching_edges() const {
+    EdgeList result;
+    result.reserve(_matching_size);
+    for (NodeId i = 0; i < _mates.size(); ++i) {
+        if (_mates.at(i) != unmatched and i < _mates.at(i)) {
+            result.emplace_back(i, _mates.at(i));
+        }
+    }
+    return result;
+}
+
+SolverStatistics const& MatchingSolver::statistics() const {
+    return _statistics;
+}
+
+bool MatchingSolver::was_cancelled() const {
+    return _cancelled;
+}
+
+size_t MatchingSolver::matching_upper_bound() const {
+    return _matching_upper_bound;
+}
+
+template<typename GraphT>
+std::vector<NodeId> const& MatchingSolver::solve_impl(
+        GraphT const& graph, std::vector<char> const* vertex_mask, EdgeList const* initial_matching
+) {
+    MaximumMatchingAlgorithm<GraphT> algorithm(
+            graph, vertex_mask ? *vertex_mask : std::vector<char>(graph.num_nodes(), true), _config
+    );
+    if (_resume_checkpoint) {
+        auto const checkpoint = std::move(*_resume_checkpoint);
+        _resume_checkpoint.reset();
+        algorithm.resume_from(checkpoint);
+    } else if (initial_matching) {
+        algorithm.set_initial_matching(*initial_matching);
+    }
+    algorithm.set_cancellation_token(_cancellation);
+    if (_progress_callback) {
+        algorithm.set_progress_callback(_progress_callback, _progress_interval_seconds);
+    }
+    if (not _checkpoint_file.empty()) {
+        algorithm.set_checkpoint_file(_checkpoint_file, _checkpoint_interval_seconds);
+    }
+    auto const& matching_edges = algorithm.calc_maximum_matching();
+    _mates.assign(graph.num_nodes(), unmatched);
+    for (auto const&[end_a, end_b] : matching_edges) {
+        _mates.at(end_a) = end_b;
+        _mates.at(end_b) = end_a;
+    }
+    _matching_size = matching_edges.size();
+    _statistics = algorithm.statistics();
+    _cancelled = algorithm.was_cancelled();
+    _matching_upper_bound = algorithm.matching_upper_bound();
+    return _mates;
+}
@@ -0,0 +1,125 @@
+#ifndef MAXMATCHING_MATCHING_SOLVER_H
+#define MAXMATCHING_MATCHING_SOLVER_H
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "csr_graph.h"
+#include "compressed_graph.h"
+#include "cancellation.h"
+#include "checkpoint.h"
+#include "solver_config.h"
+#include "solver_progress.h"
+#include "solver_statistics.h"
+
+/**
+ * Entry point of libmaxmatching for C++ callers. A solver handle can be reused for any number of graphs, the buffers
+ * for edge list conversion and the mate array are kept between calls.
+ *
+ * All solve methods return the mate array: mates[v] is the node v is matched to, or MatchingSolver::unmatched. The
+ * reference stays valid until the next call on this handle.
+ */
+class MatchingSolver {
+public:
+    static auto constexpr unmatched = std::numeric_limits<NodeId>::max();
+
+    /**
+     * Computes a maximum matching of a graph given as CSR arrays, see CsrGraphView. The arrays are not copied.
+     */
+    std::vector<NodeId> const& solve(CsrGraphView const& graph);
+
+    std::vector<NodeId> const& solve(Graph const& graph);
+
+    std::vector<NodeId> const& solve(CompressedGraph const& graph);
+
+    /**
+     * Computes a maximum matching of the graph with the given edges. The edges are converted to CSR format in a buffer
+     * owned by this handle.
+     * @param edge_ends Array of 2 * num_edges node ids, edge i is {edge_ends[2i], edge_ends[2i + 1]}
+     */
+    std::vector<NodeId> const& solve_edge_list(NodeId num_nodes, NodeId const* edge_ends, size_t num_edges);
+
+    /**
+     * Computes a maximum matching of the subgraph induced by the nodes with a non-zero entry in vertex_mask. Nodes
+     * outside of the subgraph are unmatched in the result.
+     */
+    std::vector<NodeId> const& solve_subgraph(CsrGraphView const& graph, std::vector<char> const& vertex_mask);
+
+    /**
+     * Computes a maximum matching starting from the matching given by a mate array (in the format returned by the
+     * solve methods). Throws an exception if the mate array does not describe a matching of the graph.
+     */
+    std::vector<NodeId> const& solve_warm_start(CsrGraphView const& graph, std::vector<NodeId> const& initial_mates);
+
+    /// Settings used by all following calls
+    void set_config(SolverConfig const& config);
+
+    /**
+     * All following calls stop early once the token is cancelled (e.g. at its deadline), returning the valid but
+     * possibly not maximum matching found so far, see was_cancelled and matching_upper_bound. nullptr to always run
+     * to completion. The token needs to outlive the calls.
+     */
+    void set_cancellation_token(CancellationToken const* cancellation);
+
+    /// Report the progress of all following calls, see MaximumMatchingAlgorithm::set_progress_callback
+    void set_progress_callback(ProgressCallback callback, double interval_seconds);
+
+    /**
+     * Checkpoint all following calls to the file, see MaximumMatchingAlgorithm::set_checkpoint_file. An empty file
+     * name disables checkpointing.
+     */
+    void set_checkpoint_file(std::string file_name, double interval_seconds);
+
+    /**
+     * The next call continues from the checkpoint, which needs to have been written for the same graph. The vertex
+     * mask or initial matching of that call are ignored, the checkpoint already contains them.
+     */
+    void resume_from(SolverCheckpoint checkpoint);
+
+    /// @return The mate array computed by the last call
+    [[nodiscard]] std::vector<NodeId> const& mates() const;
+
+    /// @return The number of edges in the matching computed by the last call
+    [[nodiscard]] size_t matching_size() const;
+
+    /// @return The edges of the matching computed by the last call, with the smaller end first
+    [[nodiscard]] EdgeList matching_edges() const;
+
+    /// @return Statistics of the last call
+    [[nodiscard]] SolverStatistics const& statistics() const;
+
+    /// @return Whether the last call was cancelled, so its matching is not necessarily maximum
+    [[nodiscard]] bool was_cancelled() const;
+
+    /// @return An upper bound on the size of a maximum matching, known from the last call
+    [[nodiscard]] size_t matching_upper_bound() const;
+
+private:
+    /**
+     * @param vertex_mask The allowed vertices, nullptr to allow all
+     * @param initial_matching Edges to start from, nullptr to start from the empty matching
+     */
+    template<typename GraphT>
+    std::vector<NodeId> const& solve_impl(
+            GraphT const& graph, std::vector<char> const* vertex_mask = nullptr,
+            EdgeList const* initial_matching = nullptr
+    );
+
+    CsrGraph _edge_list_graph;
+    std::vector<NodeId> _mates;
+    size_t _matching_size = 0;
+    SolverConfig _config;
+    SolverStatistics _statistics;
+    CancellationToken const* _cancellation = nullptr;
+    ProgressCallback _progress_callback;
+    double _progress_interval_seconds = 0;
+    bool _cancelled = false;
+    size_t _matching_upper_bound = 0;
+    std::string _checkpoint_file;
+    double _checkpoint_interval_seconds = 0;
+    std::optional<SolverCheckpoint> _resume_checkpoint;
+};
+
+
+#endif //MAXMATCHING_MATCHING_SOLVER_H
@@ -1,52 +1,291 @@
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 #include "maximum_matching_algorithm.h"
 #include "perfect_matching_algorithm.h"
+#include "csr_graph.h"
+#include "compressed_graph.h"
+#include "perf_counters.h"
+#include "trace.h"
 
-MaximumMatchingAlgorithm::MaximumMatchingAlgorithm(Graph const& graph)
+template<typename GraphT>
+MaximumMatchingAlgorithm<GraphT>::MaximumMatchingAlgorithm(GraphT const& graph, SolverConfig config)
+        : MaximumMatchingAlgorithm(graph, std::vector<char>(graph.num_nodes(), true), config) {}
+
+template<typename GraphT>
+MaximumMatchingAlgorithm<GraphT>::MaximumMatchingAlgorithm(GraphT const& graph, std::vector<char> allowed_vertices,
+                                                           SolverConfig config)
         : _graph(graph),
           _current_matching(_graph.num_nodes()),
-          _allowed(_graph.num_nodes(), true) {}
+          _allowed(std::move(allowed_vertices)),
+          _config(config) {
+    assert(_allowed.size() == _graph.num_nodes());
+    _num_blocked_nodes = std::count(_allowed.begin(), _allowed.end(), false);
+    _num_initially_blocked_nodes = _num_blocked_nodes;
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::set_initial_matching(EdgeList const& edges) {
+    for (auto const&[end_a, end_b] : edges) {
+        assert(_allowed.at(end_a) and _allowed.at(end_b));
+        _current_matching.add_edge(end_a, end_b);
+    }
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::set_cancellation_token(CancellationToken const* cancellation) {
+    _cancellation = cancellation;
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::set_progress_callback(ProgressCallback callback, double interval_seconds) {
+    _progress_callback = std::move(callback);
+    _progress_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(interval_seconds)
+    );
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::set_checkpoint_file(std::string file_name, double interval_seconds) {
+    _checkpoint_writer = std::make_unique<CheckpointWriter>(std::move(file_name));
+    _checkpoint_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(interval_seconds)
+    );
+}
 
-EdgeList MaximumMatchingAlgorithm::calc_maximum_matching() {
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::resume_from(SolverCheckpoint const& checkpoint) {
+    assert(_current_matching.size() == 0);
+    if (checkpoint.num_nodes != _graph.num_nodes() or checkpoint.num_edge_ends != num_edge_ends()) {
+        throw std::runtime_error("Checkpoint was written for a different graph");
+    }
+    _allowed = checkpoint.allowed;
+    _num_blocked_nodes = checkpoint.num_blocked_nodes;
+    _num_initially_blocked_nodes = checkpoint.num_initially_blocked_nodes;
+    _num_blocked_exposed_nodes = checkpoint.num_blocked_exposed_nodes;
+    // Not set_initial_matching: Vertices matched by match_leaves are blocked but stay matched
+    for (NodeId i = 0; i < _graph.num_nodes(); ++i) {
+        auto const& mate = checkpoint.mates.at(i);
+        if (mate != SolverCheckpoint::unmatched and i < mate) {
+            _current_matching.add_edge(i, mate);
+        }
+    }
+    _resumed = true;
+}
+
+template<typename GraphT>
+EdgeList MaximumMatchingAlgorithm<GraphT>::calc_maximum_matching() {
+    using Clock = std::chrono::steady_clock;
+    _statistics = {};
+    _cancelled = false;
+    _current_matching.set_statistics(&_statistics);
+    auto const& leaves_start = Clock::now();
+    _solve_start = leaves_start;
+    _last_progress_report = leaves_start;
+    _last_reported_size = _current_matching.size();
+    _last_checkpoint = leaves_start;
+    if (not _resumed) {
+        match_leaves();
+    }
+    report_progress();
+    auto const& exact_start = Clock::now();
+    _statistics.leaves_seconds = std::chrono::duration<double>(exact_start - leaves_start).count();
+    switch (_config.tree_search) {
+        case TreeSearch::depth_first:
+            run_exact_search<DepthFirstOrder>();
+            break;
+        case TreeSearch::breadth_first:
+            run_exact_search<BreadthFirstOrder>();
+            break;
+        case TreeSearch::hybrid:
+            run_exact_search<HybridOrder>();
+            break;
+    }
+    _statistics.exact_seconds = std::chrono::duration<double>(Clock::now() - exact_start).count();
+    _current_matching.set_statistics(nullptr);
+    report_progress(true);
+    if (_checkpoint_writer) {
+        if (_cancelled) {
+            _checkpoint_writer->write_async(make_checkpoint());
+        }
+        _checkpoint_writer->wait();
+    }
+    return _current_matching.get_matching_edges();
+}
+
+template<typename GraphT>
+template<typename SearchOrder>
+void MaximumMatchingAlgorithm<GraphT>::run_exact_search() {
+    trace::Scope scope("exact_search");
+    perf_counters::PhaseScope phase(perf_counters::Phase::tree_growth);
     bool is_maximum = false;
-    match_leaves();
-    PerfectMatchingAlgorithm perfect_alg(_current_matching, _graph, _allowed);
-    while (not is_maximum and _graph.num_nodes() > _num_blocked_nodes + 1) {
+    PerfectMatchingAlgorithm<GraphT, SearchOrder> perfect_alg(
+            _current_matching, _graph, _allowed, _config, &_statistics, _cancellation
+    );
+    if (_progress_callback or _checkpoint_writer) {
+        perfect_alg.set_augmentation_callback([this]() { on_safe_point(); });
+    }
+    while (not is_maximum and not _cancelled and _graph.num_nodes() > _num_blocked_nodes + 1) {
         auto const& tree_vertices = perfect_alg.calculate_matching_or_frustrated_tree();
         if (tree_vertices) {
             // Nodes that were part of the tree are not allowed to be used in further trees
             // If any nodes become isolated after removing these
             for (auto const& to_remove : *tree_vertices) {
-                assert(_allowed.at(to_remove));
-                _allowed.at(to_remove) = false;
-                ++_num_blocked_nodes;
+                block(to_remove);
             }
+            on_safe_point();
+        } else if (perfect_alg.is_cancelled()) {
+            _cancelled = true;
         } else {
             is_maximum = true;
         }
     }
-    return _current_matching.get_matching_edges();
 }
 
-void MaximumMatchingAlgorithm::match_leaves() {
+template<typename GraphT>
+bool MaximumMatchingAlgorithm<GraphT>::was_cancelled() const {
+    return _cancelled;
+}
+
+template<typename GraphT>
+size_t MaximumMatchingAlgorithm<GraphT>::matching_upper_bound() const {
+    return (_graph.num_nodes() - _num_initially_blocked_nodes - _num_blocked_exposed_nodes) / 2;
+}
+
+template<typename GraphT>
+SolverStatistics const& MaximumMatchingAlgorithm<GraphT>::statistics() const {
+    return _statistics;
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::match_leaves() {
+    trace::Scope scope("match_leaves");
+    perf_counters::PhaseScope phase(perf_counters::Phase::preprocessing);
     // Match each node with leaf neighbors to one of those. This can significantly decrease
     // the number of nodes that need to be considered by the main algorithm without 
     // destroying optimality: If a node with leaf neighbors is matched to some other 
     // neighbor in a maximum matching we can always replace that edge with one to a leaf
     for (NodeId i = 0; i < _graph.num_nodes(); ++i) {
-        auto const& node = _graph.node(i);
-        if (node.degree() != 1) {
+        if (not _allowed.at(i)) {
             continue;
         }
-        _allowed.at(i) = false;
-        ++_num_blocked_nodes;
-        auto const& neighbor = node.neighbors().front();
-        if (_current_matching.is_matched(Representative(neighbor))) {
+        // Degree in the subgraph induced by the allowed nodes, we only need to know whether it is 0, 1 or more
+        size_type allowed_degree = 0;
+        NodeId neighbor{};
+        for (auto const& other : _graph.node(i).neighbors()) {
+            if (_allowed.at(other)) {
+                neighbor = other;
+                if (++allowed_degree > 1) {
+                    break;
+                }
+            }
+        }
+        if (allowed_degree == 0) {
+            // Isolated (possibly since its neighbors were blocked as leaves or their partners) => never matched
+            block(i);
+            continue;
+        } else if (allowed_degree > 1) {
             continue;
         }
-        assert(not _current_matching.is_matched(Representative(i)));
-        _current_matching.add_edge(i, neighbor);
-        _allowed.at(neighbor) = false;
-        ++_num_blocked_nodes;
+        Representative neighbor_repr(neighbor);
+        if (_current_matching.is_matched(neighbor_repr) and not _current_matching.contains_edge(
+                neighbor_repr, Representative(i)
+        )) {
+            // Only possible when starting from an initial matching: Replace the neighbor's matching edge by the edge
+            // to the leaf, this does not change the size of the matching
+            _current_matching.remove_edge(neighbor, _current_matching.other_end(neighbor_repr).id());
+        }
+        if (not _current_matching.is_matched(neighbor_repr)) {
+            _current_matching.add_edge(i, neighbor);
+        }
+        block(i);
+        block(neighbor);
+    }
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::block(NodeId node) {
+    assert(_allowed.at(node));
+    _allowed.at(node) = false;
+    ++_num_blocked_nodes;
+    if (not _current_matching.is_matched(Representative(node))) {
+        ++_num_blocked_exposed_nodes;
+    }
+#ifdef MAXMATCHING_STATISTICS
+    ++_statistics.blocked_vertices;
+#endif
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::report_progress(bool force) {
+    if (not _progress_callback) {
+        return;
+    }
+    auto const& now = std::chrono::steady_clock::now();
+    if (not force and now - _last_progress_report < _progress_interval) {
+        return;
+    }
+    SolverProgress progress;
+    progress.matching_size = _current_matching.size();
+    progress.upper_bound = matching_upper_bound();
+    progress.seconds = std::chrono::duration<double>(now - _solve_start).count();
+    auto const& elapsed = std::chrono::duration<double>(now - _last_progress_report).count();
+    if (elapsed > 0) {
+        progress.edges_per_second = static_cast<double>(progress.matching_size - _last_reported_size) / elapsed;
+    }
+    _last_progress_report = now;
+    _last_reported_size = progress.matching_size;
+    _progress_callback(progress);
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::on_safe_point() {
+    report_progress();
+    write_checkpoint_if_due();
+}
+
+template<typename GraphT>
+void MaximumMatchingAlgorithm<GraphT>::write_checkpoint_if_due() {
+    if (not _checkpoint_writer) {
+        return;
+    }
+    auto const& now = std::chrono::steady_clock::now();
+    if (now - _last_checkpoint < _checkpoint_interval or not _checkpoint_writer->is_idle()) {
+        return;
+    }
+    _checkpoint_writer->write_async(make_checkpoint());
+    _last_checkpoint = now;
+}
+
+template<typename GraphT>
+SolverCheckpoint MaximumMatchingAlgorithm<GraphT>::make_checkpoint() const {
+    SolverCheckpoint result;
+    result.num_nodes = _graph.num_nodes();
+    result.num_edge_ends = num_edge_ends();
+    result.mates.assign(_graph.num_nodes(), SolverCheckpoint::unmatched);
+    for (NodeId i = 0; i < _graph.num_nodes(); ++i) {
+        Representative repr(i);
+        if (_current_matching.is_matched(repr)) {
+            result.mates.at(i) = _current_matching.other_end(repr).id();
+        }
     }
+    result.allowed = _allowed;
+    result.num_blocked_nodes = _num_blocked_nodes;
+    result.num_initially_blocked_nodes = _num_initially_blocked_nodes;
+    result.num_blocked_exposed_nodes = _num_blocked_exposed_nodes;
+    return result;
 }
+
+template<typename GraphT>
+std::uint64_t MaximumMatchingAlgorithm<GraphT>::num_edge_ends() const {
+    std::uint64_t result = 0;
+    for (NodeId i = 0; i < _graph.num_nodes(); ++i) {
+        result += _graph.node(i).degree();
+    }
+    return result;
+}
+
+template class MaximumMatchingAlgorithm<Graph>;
+template class MaximumMatchingAlgorithm<CsrGraphView>;
+template class MaximumMatchingAlgorithm<CompressedGraph>;
@@ -2,22 +2,129 @@
 #define MAXMATCHING_MAXIMUM_MATCHING_ALGORITHM_H
 
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include "cancellation.h"
+#include "checkpoint.h"
 #include "graph.h"
 #include "matching.h"
+#include "solver_config.h"
+#include "solver_progress.h"
+#include "solver_statistics.h"
 
+/**
+ * @tparam GraphT The graph type, Graph, CsrGraphView or CompressedGraph. The explicit instantiations are in the source
+ * file.
+ */
+template<typename GraphT>
 class MaximumMatchingAlgorithm {
 public:
-    explicit MaximumMatchingAlgorithm(Graph const& graph);
+    /**
+     * The graph is not copied, so it needs to outlive this object.
+     */
+    explicit MaximumMatchingAlgorithm(GraphT const& graph, SolverConfig config = {});
 
+    /**
+     * Computes a maximum matching of the subgraph induced by the vertices with a non-zero entry in allowed_vertices.
+     */
+    MaximumMatchingAlgorithm(GraphT const& graph, std::vector<char> allowed_vertices, SolverConfig config = {});
+
+    /**
+     * Start from the given matching instead of the empty one. This needs to be called before calc_maximum_matching.
+     * @param edges Edges of the graph forming a matching on the allowed vertices
+     */
+    void set_initial_matching(EdgeList const& edges);
+
+    /**
+     * Stop the search when the token is cancelled, see CancellationToken. The token needs to outlive
+     * calc_maximum_matching.
+     */
+    void set_cancellation_token(CancellationToken const* cancellation);
+
+    /**
+     * Report the progress of calc_maximum_matching to the callback at most every interval_seconds, and once more when
+     * it returns. The callback runs on the solving thread between trees, so it should return quickly.
+     */
+    void set_progress_callback(ProgressCallback callback, double interval_seconds);
+
+    /**
+     * Write the state of calc_maximum_matching to the file at most every interval_seconds, see SolverCheckpoint. The
+     * state is copied between two trees and written on a background thread; if the previous write is still running
+     * the checkpoint is skipped instead of waiting for it. A search that gets cancelled writes a final checkpoint
+     * before returning.
+     */
+    void set_checkpoint_file(std::string file_name, double interval_seconds);
+
+    /**
+     * Continue from a checkpoint written for the same graph instead of starting from the empty matching. This needs
+     * to be called on a newly constructed object before calc_maximum_matching. Throws an exception if the checkpoint
+     * does not match the graph.
+     */
+    void resume_from(SolverCheckpoint const& checkpoint);
+
+    /**
+     * @return A maximum matching, or the matching found so far if the search was cancelled
+     */
     EdgeList calc_maximum_matching();
 
+    /// @return Whether the last call to calc_maximum_matching was cancelled before the matching was maximum
+    [[nodiscard]] bool was_cancelled() const;
+
+    /**
+     * @return An upper bound on the size of a maximum matching: Every blocked vertex that is not covered (the root of a
+     * frustrated tree, or a vertex isolated by blocking) is not covered by some maximum matching either. Equal to the
+     * size of the matching once calc_maximum_matching finished without being cancelled.
+     */
+    [[nodiscard]] size_t matching_upper_bound() const;
+
+    /// @return Statistics of the last call to calc_maximum_matching
+    [[nodiscard]] SolverStatistics const& statistics() const;
+
 private:
     void match_leaves();
 
-    Graph const& _graph;
+    /// Grows trees until the matching is maximum, blocking the vertices of frustrated trees
+    template<typename SearchOrder>
+    void run_exact_search();
+
+    void block(NodeId node);
+
+    /// Calls the progress callback if the report interval has passed since the last report or if forced
+    void report_progress(bool force = false);
+
+    /// Called between two trees: Reports progress and writes a checkpoint if their intervals have passed
+    void on_safe_point();
+
+    /// Hands a copy of the current state to the checkpoint writer if the interval has passed and it is idle
+    void write_checkpoint_if_due();
+
+    [[nodiscard]] SolverCheckpoint make_checkpoint() const;
+
+    [[nodiscard]] std::uint64_t num_edge_ends() const;
+
+    GraphT const& _graph;
     Matching _current_matching;
     std::vector<char> _allowed;
     size_t _num_blocked_nodes = 0;
+    /// Vertices that were not allowed from the start, they do not count for the upper bound
+    size_t _num_initially_blocked_nodes = 0;
+    /// Blocked vertices that are not covered by the matching
+    size_t _num_blocked_exposed_nodes = 0;
+    SolverConfig _config;
+    SolverStatistics _statistics;
+    CancellationToken const* _cancellation = nullptr;
+    bool _cancelled = false;
+    ProgressCallback _progress_callback;
+    std::chrono::steady_clock::duration _progress_interval{};
+    std::chrono::steady_clock::time_point _solve_start;
+    std::chrono::steady_clock::time_point _last_progress_report;
+    size_t _last_reported_size = 0;
+    std::unique_ptr<CheckpointWriter> _checkpoint_writer;
+    std::chrono::steady_clock::duration _checkpoint_interval{};
+    std::chrono::steady_clock::time_point _last_checkpoint;
+    /// Whether the state was restored by resume_from, the leaves have been matched before the checkpoint then
+    bool _resumed = false;
 };
 
 
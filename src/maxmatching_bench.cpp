@@ -0,0 +1,245 @@
+/**
+ * Microbenchmarks of the core data structures, built as maxmatching_bench if Google Benchmark is installed.
+ *
+ * Use a release build (-DCMAKE_BUILD_TYPE=Release), with assertions the validation code dominates every benchmark.
+ * To compare two commits, run both with
+ *   maxmatching_bench --benchmark_repetitions=10 --benchmark_out=<file>.json --benchmark_out_format=json
+ * and compare the JSON files with compare_benchmarks.py.
+ */
+#include <random>
+#include <sstream>
+#include <benchmark/benchmark.h>
+#include "alternating_tree.h"
+#include "csr_graph.h"
+#include "dimacs_edge_stream.h"
+#include "graph.h"
+#include "matching.h"
+#include "maximum_matching_algorithm.h"
+#include "nested_shrinking.h"
+
+namespace {
+
+/// Edges of a random graph with the given number of nodes and edges, without loops (parallel edges are possible)
+std::vector<NodeId> random_edge_ends(NodeId num_nodes, size_t num_edges, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<NodeId> node(0, num_nodes - 1);
+    std::vector<NodeId> edge_ends;
+    edge_ends.reserve(2 * num_edges);
+    while (edge_ends.size() < 2 * num_edges) {
+        auto const& end_a = node(random);
+        auto const& end_b = node(random);
+        if (end_a != end_b) {
+            edge_ends.push_back(end_a);
+            edge_ends.push_back(end_b);
+        }
+    }
+    return edge_ends;
+}
+
+std::string random_dimacs(NodeId num_nodes, size_t num_edges) {
+    auto const& edge_ends = random_edge_ends(num_nodes, num_edges, 1);
+    std::ostringstream output;
+    output << "c random graph\np edge " << num_nodes << ' ' << num_edges << '\n';
+    for (size_t i = 0; i < edge_ends.size(); i += 2) {
+        output << "e " << edge_ends.at(i) + 1 << ' ' << edge_ends.at(i + 1) + 1 << '\n';
+    }
+    return output.str();
+}
+
+/**
+ * Shrinks depth nested sets: The first one consists of set_size single nodes, each further one of the previous set
+ * and set_size - 1 single nodes. Then expands all of them again.
+ * Args: depth, set_size
+ */
+void BM_NestedShrinkingShrinkExpand(benchmark::State& state) {
+    auto const& depth = static_cast<NodeId>(state.range(0));
+    auto const& set_size = static_cast<NodeId>(state.range(1));
+    NestedShrinking shrinking(depth * (set_size - 1) + 1);
+    for (auto _ : state) {
+        Representative previous(0);
+        NodeId next_node = 1;
+        for (NodeId level = 0; level < depth; ++level) {
+            Representatives to_shrink{previous};
+            for (NodeId i = 1; i < set_size; ++i) {
+                to_shrink.emplace_back(next_node++);
+            }
+            previous = shrinking.shrink(to_shrink);
+        }
+        while (shrinking.is_shrunken()) {
+            benchmark::DoNotOptimize(shrinking.expand());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+
+/**
+ * Shrinks and expands an odd cycle in which all nodes except node 0 are matched along the cycle.
+ * Args: cycle length
+ */
+void BM_MatchingShrinkExpand(benchmark::State& state) {
+    auto const& length = static_cast<NodeId>(state.range(0));
+    Matching matching(length);
+    NestedShrinking shrinking(length);
+    Representatives cycle;
+    EdgeList cycle_edges;
+    for (NodeId i = 0; i < length; ++i) {
+        cycle.emplace_back(i);
+        cycle_edges.emplace_back(i == 0 ? length - 1 : i - 1, i);
+        if (i % 2 == 1) {
+            matching.add_edge(i, i + 1);
+        }
+    }
+    for (auto _ : state) {
+        auto const& shrunken = shrinking.shrink(cycle);
+        matching.shrink(cycle, EdgeList(cycle_edges), shrunken);
+        auto const&[expanded, name] = shrinking.expand();
+        matching.expand(name, expanded, shrinking);
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+/**
+ * Augments along an alternating path with exposed ends, the original matching is restored outside of the timing.
+ * Args: number of path nodes (even)
+ */
+void BM_MatchingAugmentAlong(benchmark::State& state) {
+    auto const& length = static_cast<NodeId>(state.range(0));
+    Matching matching(length);
+    Representatives path;
+    EdgeList path_edges;
+    for (NodeId i = 0; i < length; ++i) {
+        path.emplace_back(i);
+        if (i + 1 < length) {
+            path_edges.emplace_back(i, i + 1);
+        }
+        if (i % 2 == 1 and i + 1 < length) {
+            matching.add_edge(i, i + 1);
+        }
+    }
+    for (auto _ : state) {
+        matching.augment_along(path, path_edges);
+        state.PauseTiming();
+        for (NodeId i = 0; i + 1 < length; i += 2) {
+            matching.remove_edge(i, i + 1);
+        }
+        for (NodeId i = 1; i + 1 < length; i += 2) {
+            matching.add_edge(i, i + 1);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+/**
+ * Grows a tree consisting of two alternating paths of the given depth below the root (outside of the timing) and
+ * shrinks the circuit closed by an edge between their deepest even nodes, which needs to find the circuit through the
+ * root.
+ * Args: depth (number of matching edges per path)
+ */
+void BM_AlternatingTreeDeepCircuit(benchmark::State& state) {
+    auto const& depth = static_cast<NodeId>(state.range(0));
+    auto const& num_nodes = 4 * depth + 1;
+    auto const& end_a = 2 * depth;
+    auto const& end_b = 4 * depth;
+    for (auto _ : state) {
+        state.PauseTiming();
+        // Expanding the circuit changes which node is exposed, so start from scratch every time
+        Matching matching(num_nodes);
+        for (NodeId i = 1; i < num_nodes; i += 2) {
+            matching.add_edge(i, i + 1);
+        }
+        AlternatingTree tree(matching, 0);
+        for (NodeId path_start : {NodeId(1), 2 * depth + 1}) {
+            NodeId even_node = 0;
+            for (NodeId i = 0; i < depth; ++i) {
+                auto const& odd_node = path_start + 2 * i;
+                tree.extend(tree.get_representative(even_node), even_node, odd_node);
+                even_node = odd_node + 1;
+            }
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(tree.shrink_fundamental_circuit(
+                tree.get_representative(end_a), end_a, tree.get_representative(end_b), end_b
+        ));
+        state.PauseTiming();
+        tree.unshrink();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+
+/**
+ * Computes a maximum matching of a random graph with 1.5 edges per node, reporting the edges scanned while growing
+ * trees per second.
+ * Args: number of nodes, tree search order (0: DFS, 1: BFS, 2: hybrid)
+ */
+void BM_TreeGrowth(benchmark::State& state) {
+    auto const& num_nodes = static_cast<NodeId>(state.range(0));
+    auto const& edge_ends = random_edge_ends(num_nodes, 3 * size_t(num_nodes) / 2, 2);
+    CsrGraph graph;
+    graph.assign_from_edge_list(num_nodes, edge_ends.data(), edge_ends.size() / 2);
+    SolverConfig config;
+    config.tree_search = static_cast<TreeSearch>(state.range(1));
+    size_t edges_scanned = 0;
+    for (auto _ : state) {
+        MaximumMatchingAlgorithm<CsrGraphView> algorithm(graph.view(), config);
+        benchmark::DoNotOptimize(algorithm.calc_maximum_matching());
+        edges_scanned += algorithm.statistics().edges_scanned;
+    }
+    if (SolverStatistics::counters_enabled) {
+        state.SetItemsProcessed(static_cast<std::int64_t>(edges_scanned));
+    }
+}
+
+/**
+ * Builds a Graph from DIMACS text in memory.
+ * Args: number of nodes (with 3 edges per node)
+ */
+void BM_ReadDimacsGraph(benchmark::State& state) {
+    auto const& text = random_dimacs(state.range(0), 3 * state.range(0));
+    for (auto _ : state) {
+        std::istringstream input(text);
+        benchmark::DoNotOptimize(Graph::read_dimacs(input));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+
+/**
+ * Only tokenizes DIMACS text, without building a graph.
+ * Args: number of nodes (with 3 edges per node)
+ */
+void BM_DimacsEdgeStream(benchmark::State& state) {
+    auto const& text = random_dimacs(state.range(0), 3 * state.range(0));
+    for (auto _ : state) {
+        std::istringstream input(text);
+        DimacsEdgeStream edges(input);
+        while (auto const& edge = edges.next_edge()) {
+            benchmark::DoNotOptimize(edge->first);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+
+} // end of anonymous namespace
+
+BENCHMARK(BM_NestedShrinkingShrinkExpand)->ArgsProduct({{1, 8, 64}, {3, 33}});
+BENCHMARK(BM_MatchingShrinkExpand)->Arg(3)->Arg(9)->Arg(65)->Arg(513);
+BENCHMARK(BM_MatchingAugmentAlong)->RangeMultiplier(16)->Range(16, 4096);
+BENCHMARK(BM_AlternatingTreeDeepCircuit)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_TreeGrowth)->ArgsProduct({{10000, 30000}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadDimacsGraph)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DimacsEdgeStream)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+#ifdef NDEBUG
+    benchmark::AddCustomContext("maxmatching_assertions", "disabled");
+#else
+    benchmark::AddCustomContext("maxmatching_assertions", "enabled, results are not representative");
+#endif
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <new>
+#include <string>
+#include "maxmatching_c.h"
+#include "matching_solver.h"
+
+static_assert(std::is_same_v<NodeId, uint32_t>, "The C interface assumes 32 bit node ids");
+static_assert(std::is_same_v<EdgeIndex, uint64_t>, "The C interface assumes 64 bit edge offsets");
+static_assert(MatchingSolver::unmatched == MAXMATCHING_UNMATCHED);
+
+struct maxmatching_solver {
+    MatchingSolver solver;
+    std::string last_error;
+};
+
+namespace {
+
+// Exceptions must not cross the C boundary, so convert them to an error code and store the message in the handle.
+template<typename Function>
+int run_and_catch(maxmatching_solver* solver, Function&& function) {
+    if (solver == nullptr) {
+        return 1;
+    }
+    try {
+        solver->last_error.clear();
+        function(solver->solver);
+        return 0;
+    } catch (std::exception const& xcp) {
+        solver->last_error = xcp.what();
+        return 1;
+    }
+}
+
+void write_results(MatchingSolver const& solver, uint32_t* mates_out, uint64_t* matching_size_out) {
+    std::copy(solver.mates().begin(), solver.mates().end(), mates_out);
+    if (matching_size_out != nullptr) {
+        *matching_size_out = solver.matching_size();
+    }
+}
+
+} // end of anonymous namespace
+
+maxmatching_solver* maxmatching_solver_create() {
+    return new(std::nothrow) maxmatching_solver;
+}
+
+void maxmatching_solver_destroy(maxmatching_solver* solver) {
+    delete solver;
+}
+
+int maxmatching_solve_csr(
+        maxmatching_solver* solver, uint32_t num_nodes, uint64_t const* offsets, uint32_t const* targets,
+        uint32_t* mates_out, uint64_t* matching_size_out
+) {
+    return run_and_catch(solver, [&](MatchingSolver& cpp_solver) {
+        cpp_solver.solve(CsrGraphView(num_nodes, offsets, targets));
+        write_results(cpp_solver, mates_out, matching_size_out);
+    });
+}
+
+int maxmatching_solve_edge_list(
+        maxmatching_solver* solver, uint32_t num_nodes, uint32_t const* edge_ends, uint64_t num_edges,
+        uint32_t* mates_out, uint64_t* matching_size_out
+) {
+    return run_and_catch(solver, [&](MatchingSolver& cpp_solver) {
+        cpp_solver.solve_edge_list(num_nodes, edge_ends, num_edges);
+        write_results(cpp_solver, mates_out, matching_size_out);
+    });
+}
+
+char const* maxmatching_last_error(maxmatching_solver const* solver) {
+    return solver == nullptr ? "Invalid solver handle" : solver->last_error.c_str();
+}
@@ -0,0 +1,54 @@
+#ifndef MAXMATCHING_MAXMATCHING_C_H
+#define MAXMATCHING_MAXMATCHING_C_H
+
+/*
+ * C interface of libmaxmatching, intended for FFI. All functions returning int return 0 on success and a non-zero
+ * value on failure, in which case maxmatching_last_error describes the problem.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Mate array entry for unmatched nodes */
+#define MAXMATCHING_UNMATCHED UINT32_MAX
+
+typedef struct maxmatching_solver maxmatching_solver;
+
+/** @return A new solver handle, or NULL if allocation failed. Buffers are kept in the handle between calls. */
+maxmatching_solver* maxmatching_solver_create(void);
+
+void maxmatching_solver_destroy(maxmatching_solver* solver);
+
+/**
+ * Computes a maximum matching of a graph in CSR format. The neighbors of node i are
+ * targets[offsets[i]], ..., targets[offsets[i + 1] - 1], each edge has to be listed at both ends. The arrays are used
+ * in place without copying.
+ * @param mates_out Array of num_nodes entries, receives the mate of each node or MAXMATCHING_UNMATCHED
+ * @param matching_size_out If not NULL, receives the number of matching edges
+ */
+int maxmatching_solve_csr(
+        maxmatching_solver* solver, uint32_t num_nodes, uint64_t const* offsets, uint32_t const* targets,
+        uint32_t* mates_out, uint64_t* matching_size_out
+);
+
+/**
+ * Computes a maximum matching of a graph given by its edges: edge i is {edge_ends[2i], edge_ends[2i + 1]}.
+ * The other parameters are as in maxmatching_solve_csr.
+ */
+int maxmatching_solve_edge_list(
+        maxmatching_solver* solver, uint32_t num_nodes, uint32_t const* edge_ends, uint64_t num_edges,
+        uint32_t* mates_out, uint64_t* matching_size_out
+);
+
+/** @return A description of the last error on this handle, or an empty string */
+char const* maxmatching_last_error(maxmatching_solver const* solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAXMATCHING_MAXMATCHING_C_H */
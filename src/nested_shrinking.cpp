@@ -2,7 +2,14 @@
 #include <algorithm>
 #include "nested_shrinking.h"
 
-NestedShrinking::NestedShrinking(size_t num_nodes) : _partition(num_nodes), _set_elements(num_nodes) {
+NestedShrinking::NestedShrinking(size_t num_nodes, SolverStatistics* statistics)
+        : _partition(num_nodes),
+          _set_elements(num_nodes),
+          _statistics(statistics)
+#ifdef MAXMATCHING_STATISTICS
+        , _nesting_depth(statistics ? num_nodes : 0)
+#endif
+{
     for (NodeId i = 0; i < num_nodes; ++i) {
         Representative repr(i);
         _partition.at(i) = repr;
@@ -47,6 +54,17 @@ Representative NestedShrinking::shrink(Representatives const& to_shrink) {
             shrink_info.elements.push_back({set_repr, {}});
         }
     }
+#ifdef MAXMATCHING_STATISTICS
+    if (_statistics) {
+        size_t depth = 0;
+        for (auto const& set_repr : to_shrink) {
+            depth = std::max(depth, _nesting_depth.at(set_repr) + 1);
+        }
+        shrink_info.old_nesting_depth = _nesting_depth.at(result_representative);
+        _nesting_depth.at(result_representative) = depth;
+        _statistics->record_nesting_depth(depth);
+    }
+#endif
     _shrink_stack.push_back(std::move(shrink_info));
     validate();
     return result_representative;
@@ -79,6 +97,11 @@ std::pair<Representatives, Representative> NestedShrinking::expand() {
     auto& total_set = _set_elements.at(shrink_to_undo.new_name);
     // New elements are added at the end of the set, so we can just resize to get the correct set back
     total_set.resize(total_set.size() - non_main_sizes_sum);
+#ifdef MAXMATCHING_STATISTICS
+    if (_statistics) {
+        _nesting_depth.at(shrink_to_undo.new_name) = shrink_to_undo.old_nesting_depth;
+    }
+#endif
     validate();
     return {shrunken_vertices, shrink_to_undo.new_name};
 }
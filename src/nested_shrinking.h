@@ -3,6 +3,7 @@
 
 #include "graph.h"
 #include "representative_vector.h"
+#include "solver_statistics.h"
 
 /**
  * Stores a partition obtained by successive merging of sets in the partition, in addition to providing a way of
@@ -11,7 +12,10 @@
 class NestedShrinking {
 public:
 
-    explicit NestedShrinking(size_t num_nodes);
+    /**
+     * @param statistics Receives the maximum nesting depth of the shrinkings, may be nullptr
+     */
+    explicit NestedShrinking(size_t num_nodes, SolverStatistics* statistics = nullptr);
 
     /**
      * Perform one shrinking operation
@@ -44,6 +48,10 @@ private:
         /// The sets that were combined. If the old_name of a set is new_name, the set of affected_nodes is empty
         /// (This makes restoring the order of representatives used in the shrinking trivial)
         std::vector<SetReplacement> elements;
+#ifdef MAXMATCHING_STATISTICS
+        /// Nesting depth of new_name before the shrinking
+        size_t old_nesting_depth = 0;
+#endif
     };
 
     [[nodiscard]] size_t get_size(Representative const& set) const;
@@ -58,6 +66,11 @@ private:
     RepresentativeVector<std::vector<NodeId>> _set_elements;
 
     std::vector<ShrinkStep> _shrink_stack;
+    SolverStatistics* _statistics;
+#ifdef MAXMATCHING_STATISTICS
+    /// Number of shrinkings nested into the set of each representative, 0 for single vertices
+    RepresentativeVector<size_t> _nesting_depth;
+#endif
 };
 
 
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "perf_counters.h"
+
+namespace perf_counters {
+
+namespace {
+
+struct EventType {
+    char const* name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr std::uint64_t cache_miss_event(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+std::array<EventType, 6> const event_types{{
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"l1d_read_misses", PERF_TYPE_HW_CACHE, cache_miss_event(PERF_COUNT_HW_CACHE_L1D)},
+        {"llc_read_misses", PERF_TYPE_HW_CACHE, cache_miss_event(PERF_COUNT_HW_CACHE_LL)},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        // A software event, usually available even if the hardware events are not
+        {"task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+}};
+
+std::array<char const*, 6> const phase_names{"parse", "preprocessing", "tree_growth", "shrink", "expand", "output"};
+
+/// Event counts indexed like event_types
+using Counts = std::array<double, event_types.size()>;
+
+/**
+ * The counters of one thread, opened as a single perf event group so all of them are read with one system call.
+ */
+class CounterGroup {
+public:
+    CounterGroup() {
+        for (size_t i = 0; i < event_types.size(); ++i) {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = event_types.at(i).type;
+            attributes.config = event_types.at(i).config;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            auto const& fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, _leader, 0));
+            if (fd < 0) {
+                _error += std::string(_error.empty() ? "" : ", ") + event_types.at(i).name + ": "
+                          + std::strerror(errno);
+                continue;
+            }
+            if (_leader < 0) {
+                _leader = fd;
+            }
+            _fds.push_back(fd);
+            _event_of_value.push_back(i);
+            _available.at(i) = true;
+        }
+        _last_values.resize(_fds.size());
+        // Layout for PERF_FORMAT_GROUP: number of values, time enabled, time running, one value per event
+        _read_buffer.resize(3 + _fds.size());
+        if (available()) {
+            read_delta();
+        }
+    }
+
+    ~CounterGroup() {
+        for (auto const& fd : _fds) {
+            close(fd);
+        }
+    }
+
+    [[nodiscard]] bool available() const {
+        return _leader >= 0;
+    }
+
+    [[nodiscard]] bool is_available(size_t event) const {
+        return _available.at(event);
+    }
+
+    [[nodiscard]] std::string const& error() const {
+        return _error;
+    }
+
+    [[nodiscard]] Counts const& totals(size_t phase) const {
+        return _totals.at(phase);
+    }
+
+    void enter(Phase phase) {
+        attribute_delta();
+        _phase_stack.push_back(phase);
+    }
+
+    void leave() {
+        attribute_delta();
+        _phase_stack.pop_back();
+    }
+
+private:
+    /// Adds the events since the last read to the innermost phase
+    void attribute_delta() {
+        auto const& delta = read_delta();
+        if (not _phase_stack.empty()) {
+            auto& totals = _totals.at(static_cast<size_t>(_phase_stack.back()));
+            for (size_t i = 0; i < totals.size(); ++i) {
+                totals.at(i) += delta.at(i);
+            }
+        }
+    }
+
+    /// @return The events since the last call, scaled up if the kernel had to multiplex the counters
+    Counts read_delta() {
+        auto& buffer = _read_buffer;
+        Counts result{};
+        auto const& size = static_cast<ssize_t>(buffer.size() * sizeof(std::uint64_t));
+        if (::read(_leader, buffer.data(), size) != size) {
+            return result;
+        }
+        auto const& enabled = buffer.at(1) - _last_enabled;
+        auto const& running = buffer.at(2) - _last_running;
+        auto const& scale = running > 0 ? static_cast<double>(enabled) / static_cast<double>(running) : 1.;
+        for (size_t i = 0; i < _fds.size(); ++i) {
+            auto const& value = buffer.at(3 + i);
+            result.at(_event_of_value.at(i)) = static_cast<double>(value - _last_values.at(i)) * scale;
+            _last_values.at(i) = value;
+        }
+        _last_enabled = buffer.at(1);
+        _last_running = buffer.at(2);
+        return result;
+    }
+
+    int _leader = -1;
+    std::vector<int> _fds;
+    /// Index in event_types of each value in the group read
+    std::vector<size_t> _event_of_value;
+    std::array<bool, event_types.size()> _available{};
+    std::vector<std::uint64_t> _read_buffer;
+    std::vector<std::uint64_t> _last_values;
+    std::uint64_t _last_enabled = 0;
+    std::uint64_t _last_running = 0;
+    std::vector<Phase> _phase_stack;
+    std::array<Counts, phase_names.size()> _totals{};
+    std::string _error;
+};
+
+std::mutex groups_mutex;
+/// Counter groups of all threads that called enable
+std::vector<std::unique_ptr<CounterGroup>> groups;
+thread_local CounterGroup* thread_group = nullptr;
+
+/// Sums over all threads, with a flag per event whether any thread counted it
+std::pair<std::array<Counts, phase_names.size()>, std::array<bool, event_types.size()>> collect() {
+    std::array<Counts, phase_names.size()> totals{};
+    std::array<bool, event_types.size()> available{};
+    std::lock_guard<std::mutex> lock(groups_mutex);
+    for (auto const& group : groups) {
+        for (size_t event = 0; event < event_types.size(); ++event) {
+            if (not group->is_available(event)) {
+                continue;
+            }
+            available.at(event) = true;
+            for (size_t phase = 0; phase < phase_names.size(); ++phase) {
+                totals.at(phase).at(event) += group->totals(phase).at(event);
+            }
+        }
+    }
+    return {totals, available};
+}
+
+} // end of anonymous namespace
+
+bool enable() {
+    if (not thread_group) {
+        std::lock_guard<std::mutex> lock(groups_mutex);
+        groups.push_back(std::make_unique<CounterGroup>());
+        thread_group = groups.back().get();
+    }
+    return thread_group->available();
+}
+
+std::string error() {
+    return thread_group ? thread_group->error() : "Performance counters were not enabled";
+}
+
+void write_json(std::ostream& output) {
+    auto const&[totals, available] = collect();
+    auto const& message = error();
+    output << "{\"available\": " << (std::find(available.begin(), available.end(), true) != available.end()
+                                     ? "true" : "false")
+           << ", \"error\": \"";
+    for (auto const& c : message) {
+        output << (c == '"' or c == '\\' ? "\\" : "") << c;
+    }
+    output << "\", \"phases\": {";
+    for (size_t phase = 0; phase < phase_names.size(); ++phase) {
+        output << (phase > 0 ? ", " : "") << '"' << phase_names.at(phase) << "\": {";
+        bool first = true;
+        for (size_t event = 0; event < event_types.size(); ++event) {
+            if (available.at(event)) {
+                output << (first ? "" : ", ") << '"' << event_types.at(event).name << "\": "
+                       << static_cast<std::uint64_t>(totals.at(phase).at(event));
+                first = false;
+            }
+        }
+        output << "}";
+    }
+    output << "}}";
+}
+
+void print(std::ostream& output) {
+    auto const&[totals, available] = collect();
+    if (not error().empty()) {
+        output << "Unavailable performance counters: " << error() << '\n';
+    }
+    for (size_t phase = 0; phase < phase_names.size(); ++phase) {
+        output << "Phase " << phase_names.at(phase) << ':';
+        for (size_t event = 0; event < event_types.size(); ++event) {
+            if (available.at(event)) {
+                output << ' ' << event_types.at(event).name << '='
+                       << static_cast<std::uint64_t>(totals.at(phase).at(event));
+            }
+        }
+        output << '\n';
+    }
+}
+
+PhaseScope::PhaseScope(Phase phase) : _active(thread_group and thread_group->available()) {
+    if (_active) {
+        thread_group->enter(phase);
+    }
+}
+
+PhaseScope::~PhaseScope() {
+    if (_active) {
+        thread_group->leave();
+    }
+}
+
+} // namespace perf_counters
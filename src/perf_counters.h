@@ -0,0 +1,66 @@
+#ifndef MAXMATCHING_PERF_COUNTERS_H
+#define MAXMATCHING_PERF_COUNTERS_H
+
+#include <iosfwd>
+#include <string>
+
+/**
+ * Hardware performance counters (cycles, instructions, cache and branch misses) per solver phase, read through the
+ * Linux perf_event_open interface.
+ *
+ * Counting is done per thread: Only threads that called enable count, PhaseScope does nothing on all other threads.
+ * Phases are attributed exclusively, a nested phase (e.g. a shrink during tree growth) pauses its enclosing phase.
+ * Every phase change reads the counters with one system call, so phases should not be entered per edge.
+ *
+ * Counters the kernel or the hardware do not provide (in containers, virtual machines, or with a restrictive
+ * perf_event_paranoid setting) are reported as unavailable instead of failing.
+ */
+namespace perf_counters {
+
+enum class Phase {
+    parse,
+    /// Leaf matching
+    preprocessing,
+    /// Growing alternating trees, excluding shrinking and expanding
+    tree_growth,
+    shrink,
+    /// Expanding the blossoms of a tree after augmenting or when it is frustrated
+    expand,
+    output,
+};
+
+/**
+ * Opens the counters for the calling thread. Calling this again on the same thread has no effect.
+ * @return Whether at least one counter could be opened. If not, error() describes why.
+ */
+bool enable();
+
+/// @return The reason why counters are unavailable, empty if all counters could be opened
+[[nodiscard]] std::string error();
+
+/// Writes the counts of all phases, summed over all counting threads, as a single line JSON object
+void write_json(std::ostream& output);
+
+/// Human readable summary
+void print(std::ostream& output);
+
+/**
+ * Attributes the events of the calling thread to the given phase while it exists.
+ */
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase);
+
+    ~PhaseScope();
+
+    PhaseScope(PhaseScope const&) = delete;
+
+    PhaseScope& operator=(PhaseScope const&) = delete;
+
+private:
+    bool _active;
+};
+
+} // namespace perf_counters
+
+#endif //MAXMATCHING_PERF_COUNTERS_H
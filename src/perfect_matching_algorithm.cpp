@@ -1,32 +1,49 @@
 #include <cassert>
 #include <iostream>
+#include <algorithm>
+#include <random>
 #include "perfect_matching_algorithm.h"
 #include "alternating_tree.h"
+#include "csr_graph.h"
+#include "compressed_graph.h"
+#include "trace.h"
 
-PerfectMatchingAlgorithm::PerfectMatchingAlgorithm(Matching& matching, Graph const& graph,
-                                                   std::vector<char> const& allowed_vertices)
+template<typename GraphT, typename SearchOrder>
+PerfectMatchingAlgorithm<GraphT, SearchOrder>::PerfectMatchingAlgorithm(Matching& matching, GraphT const& graph,
+                                                           std::vector<char> const& allowed_vertices,
+                                                           SolverConfig const& config, SolverStatistics* statistics,
+                                                           CancellationToken const* cancellation)
         : _current_matching(matching),
           _graph(graph),
           _allowed_vertices(allowed_vertices),
-          _tree_for_root(_current_matching, 0) {
+          _tree_for_root(_current_matching, 0, statistics),
+          _statistics(statistics),
+          _cancellation(cancellation) {
     assert(_current_matching.total_num_nodes() == _graph.num_nodes());
     assert(_current_matching.total_num_nodes() == _allowed_vertices.size());
+    init_root_order(config);
 }
 
-EdgeList PerfectMatchingAlgorithm::find_perfect_matching() {
+template<typename GraphT, typename SearchOrder>
+EdgeList PerfectMatchingAlgorithm<GraphT, SearchOrder>::find_perfect_matching() {
     auto const& tree_vertices = calculate_matching_or_frustrated_tree();
     if (tree_vertices) {
         throw std::runtime_error("Graph does not have a perfect matching");
+    } else if (is_cancelled()) {
+        throw std::runtime_error("Search for a perfect matching was cancelled");
     } else {
         return _current_matching.get_matching_edges();
     }
 }
 
-std::optional<std::vector<NodeId>> PerfectMatchingAlgorithm::calculate_matching_or_frustrated_tree() {
-    while ((_last_root = find_uncovered_vertex())) {
+template<typename GraphT, typename SearchOrder>
+std::optional<std::vector<NodeId>> PerfectMatchingAlgorithm<GraphT, SearchOrder>::calculate_matching_or_frustrated_tree() {
+    trace::Scope call_scope("calculate_matching_or_frustrated_tree");
+    while (not is_cancelled() and (_last_root = find_uncovered_vertex())) {
+        trace::Scope tree_scope("tree", trace::Sampling::start_sample);
         _tree_for_root.reset(*_last_root);
         _edges_to_check.clear();
-        _edges_to_check.emplace_back(*_last_root);
+        _edges_to_check.push(*_last_root);
         bool augmented = false;
         std::optional<Edge> next_edge;
         while (not augmented and (next_edge = get_next_edge())) {
@@ -43,45 +60,96 @@ std::optional<std::vector<NodeId>> PerfectMatchingAlgorithm::calculate_matching_
                             repr_x, end_x, repr_y, end_y
                     );
                     for (auto const& odd_node : shrunken_odd_nodes) {
-                        _edges_to_check.emplace_back(odd_node);
+                        _edges_to_check.push(odd_node);
                     }
                 }
             } else if (_current_matching.is_matched(repr_y)) {
                 _tree_for_root.extend(repr_x, end_x, end_y);
-                _edges_to_check.emplace_back(_current_matching.other_end(repr_y).id());
+                _edges_to_check.push(_current_matching.other_end(repr_y).id());
             } else {
                 _tree_for_root.augment_and_unshrink(repr_x, end_x, end_y);
                 augmented = true;
             }
         }
+#ifdef MAXMATCHING_STATISTICS
+        if (_statistics) {
+            _statistics->record_tree(_tree_for_root.num_tree_vertices(), augmented);
+        }
+#endif
+        tree_scope.set_arg(augmented ? "vertices" : "frustrated_vertices", _tree_for_root.num_tree_vertices());
         if (not augmented) {
             // Tree is frustrated
             _tree_for_root.unshrink();
             return _tree_for_root.get_tree_vertices();
         }
+        if (_augmentation_callback) {
+            _augmentation_callback();
+        }
     }
-    // No uncovered (allowed) vertex exists => perfect
+    // No uncovered (allowed) vertex exists => perfect, unless cancelled
     return std::nullopt;
 }
 
-std::optional<NodeId> PerfectMatchingAlgorithm::find_uncovered_vertex() const {
-    auto const& first_potentially_unmatched_node = _last_root ? *_last_root + 1 : 0;
+template<typename GraphT, typename SearchOrder>
+bool PerfectMatchingAlgorithm<GraphT, SearchOrder>::is_cancelled() const {
+    return _cancellation and _cancellation->is_cancelled();
+}
+
+template<typename GraphT, typename SearchOrder>
+void PerfectMatchingAlgorithm<GraphT, SearchOrder>::set_augmentation_callback(std::function<void()> callback) {
+    _augmentation_callback = std::move(callback);
+}
+
+template<typename GraphT, typename SearchOrder>
+std::optional<NodeId> PerfectMatchingAlgorithm<GraphT, SearchOrder>::find_uncovered_vertex() {
 #ifndef NDEBUG
-    for (NodeId i = 0; i < first_potentially_unmatched_node; ++i) {
-        assert(not _allowed_vertices.at(i) or _current_matching.is_matched(Representative(i)));
+    for (size_t i = 0; i < _next_root_index; ++i) {
+        auto const& skipped = _root_order.at(i);
+        assert(not _allowed_vertices.at(skipped) or _current_matching.is_matched(Representative(skipped)));
     }
 #endif
-    for (NodeId i = first_potentially_unmatched_node; i < _allowed_vertices.size(); ++i) {
-        if (_allowed_vertices.at(i) and not _current_matching.is_matched(Representative(i))) {
-            return i;
+    for (; _next_root_index < _root_order.size(); ++_next_root_index) {
+        auto const& candidate = _root_order.at(_next_root_index);
+        if (_allowed_vertices.at(candidate) and not _current_matching.is_matched(Representative(candidate))) {
+            return candidate;
         }
     }
     return std::nullopt;
 }
 
-std::optional<Edge> PerfectMatchingAlgorithm::get_next_edge() {
+template<typename GraphT, typename SearchOrder>
+void PerfectMatchingAlgorithm<GraphT, SearchOrder>::init_root_order(SolverConfig const& config) {
+    for (NodeId i = 0; i < _graph.num_nodes(); ++i) {
+        if (_allowed_vertices.at(i) and not _current_matching.is_matched(Representative(i))) {
+            _root_order.push_back(i);
+        }
+    }
+    switch (config.root_order) {
+        case RootOrder::by_id:
+            break;
+        case RootOrder::min_degree:
+            // Stable, so nodes of the same degree stay ordered by id
+            std::stable_sort(_root_order.begin(), _root_order.end(), [this](NodeId a, NodeId b) {
+                return _graph.node(a).degree() < _graph.node(b).degree();
+            });
+            break;
+        case RootOrder::max_degree:
+            std::stable_sort(_root_order.begin(), _root_order.end(), [this](NodeId a, NodeId b) {
+                return _graph.node(a).degree() > _graph.node(b).degree();
+            });
+            break;
+        case RootOrder::random: {
+            std::mt19937 random(config.seed);
+            std::shuffle(_root_order.begin(), _root_order.end(), random);
+            break;
+        }
+    }
+}
+
+template<typename GraphT, typename SearchOrder>
+std::optional<Edge> PerfectMatchingAlgorithm<GraphT, SearchOrder>::get_next_edge() {
     while (not _edges_to_check.empty()) {
-        auto& partial_node = _edges_to_check.back();
+        auto& partial_node = _edges_to_check.current();
         if (auto const* node_id = std::get_if<NodeId>(&partial_node)) {
             // Unexpanded edge set => expand
             EdgeList edges;
@@ -100,12 +168,26 @@ std::optional<Edge> PerfectMatchingAlgorithm::get_next_edge() {
             neighbors->pop_back();
             assert(_allowed_vertices.at(next.first));
             if (_allowed_vertices.at(next.second)) {
+#ifdef MAXMATCHING_STATISTICS
+                if (_statistics) {
+                    ++_statistics->edges_scanned;
+                }
+#endif
                 return next;
             }
         } else {
-            _edges_to_check.pop_back();
+            _edges_to_check.pop_current();
         }
     }
     return std::nullopt;
 }
 
+template class PerfectMatchingAlgorithm<Graph, DepthFirstOrder>;
+template class PerfectMatchingAlgorithm<Graph, BreadthFirstOrder>;
+template class PerfectMatchingAlgorithm<Graph, HybridOrder>;
+template class PerfectMatchingAlgorithm<CsrGraphView, DepthFirstOrder>;
+template class PerfectMatchingAlgorithm<CsrGraphView, BreadthFirstOrder>;
+template class PerfectMatchingAlgorithm<CsrGraphView, HybridOrder>;
+template class PerfectMatchingAlgorithm<CompressedGraph, DepthFirstOrder>;
+template class PerfectMatchingAlgorithm<CompressedGraph, BreadthFirstOrder>;
+template class PerfectMatchingAlgorithm<CompressedGraph, HybridOrder>;
@@ -1,39 +1,78 @@
 #ifndef MAXMATCHING_PERFECT_MATCHING_ALGORITHM_H
 #define MAXMATCHING_PERFECT_MATCHING_ALGORITHM_H
 
+#include <functional>
 #include <vector>
 #include <optional>
-#include <deque>
-#include <variant>
 #include "graph.h"
 #include "matching.h"
 #include "alternating_tree.h"
+#include "cancellation.h"
+#include "solver_config.h"
+#include "solver_statistics.h"
+#include "search_order.h"
 
+/**
+ * Searches for augmenting paths from every uncovered allowed vertex until either all allowed vertices are covered or a
+ * frustrated tree is found.
+ * @tparam GraphT The graph type, Graph, CsrGraphView or CompressedGraph
+ * @tparam SearchOrder The order in which edges of even tree nodes are scanned, one of the policies in search_order.h.
+ * The explicit instantiations are in the source file.
+ */
+template<typename GraphT, typename SearchOrder = DepthFirstOrder>
 class PerfectMatchingAlgorithm {
 public:
-    explicit PerfectMatchingAlgorithm(
-            Matching& matching, Graph const& graph, std::vector<char> const& allowed_vertices
+    /**
+     * The candidate roots are the allowed vertices uncovered by the given matching, in the order given by the config.
+     * @param statistics Receives the counters of the search, may be nullptr
+     * @param cancellation Checked before each tree, may be nullptr
+     */
+    PerfectMatchingAlgorithm(
+            Matching& matching, GraphT const& graph, std::vector<char> const& allowed_vertices,
+            SolverConfig const& config = {}, SolverStatistics* statistics = nullptr,
+            CancellationToken const* cancellation = nullptr
     );
 
     [[nodiscard]] EdgeList find_perfect_matching();
 
+    /**
+     * Augments from uncovered vertices until all allowed vertices are covered, the search is cancelled, or a tree is
+     * frustrated.
+     * @return The vertices of the frustrated tree, std::nullopt otherwise (check is_cancelled() to tell apart)
+     */
     [[nodiscard]] std::optional<std::vector<NodeId>> calculate_matching_or_frustrated_tree();
 
+    /// @return Whether the cancellation token passed to the constructor was cancelled
+    [[nodiscard]] bool is_cancelled() const;
+
+    /// The callback is called after each augmentation, when no tree exists
+    void set_augmentation_callback(std::function<void()> callback);
+
 private:
-    [[nodiscard]] std::optional<NodeId> find_uncovered_vertex() const;
+    [[nodiscard]] std::optional<NodeId> find_uncovered_vertex();
+
+    void init_root_order(SolverConfig const& config);
 
     [[nodiscard]] std::optional<Edge> get_next_edge();
 
     std::optional<NodeId> _last_root;
+    /// Candidate roots in the order they are tried. Vertices never become uncovered or allowed again, so a vertex
+    /// that has been skipped never needs to be considered again.
+    std::vector<NodeId> _root_order;
+    /// Index of the next candidate in _root_order
+    size_t _next_root_index = 0;
     /**
-     * Getting all neighbors of a vertex is relatively expensive, but DFS seems to be the best search order. So store
-     * the node ID and only expand it to a list of nodes when we actually need it.
+     * Getting all neighbors of a vertex is relatively expensive, so store the node ID and only expand it to a list of
+     * nodes when we actually need it.
      */
-    std::vector<std::variant<EdgeList, NodeId>> _edges_to_check;
+    SearchOrder _edges_to_check;
     Matching& _current_matching;
-    Graph const& _graph;
+    GraphT const& _graph;
     std::vector<char> const& _allowed_vertices;
     AlternatingTree _tree_for_root;
+    SolverStatistics* _statistics;
+    CancellationToken const* _cancellation;
+    std::function<void()> _augmentation_callback;
 };
 
 
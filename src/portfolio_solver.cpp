@@ -0,0 +1,164 @@
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "portfolio_solver.h"
+#include "cancellation.h"
+#include "matching_solver.h"
+#include "maximum_matching_algorithm.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// The graph with node i renamed to map[i], as CSR arrays
+template<typename GraphT>
+CsrGraph renumbered(GraphT const& graph, std::vector<NodeId> const& map) {
+    std::vector<NodeId> edge_ends;
+    for (NodeId i = 0; i < graph.num_nodes(); ++i) {
+        for (auto const& neighbor : graph.node(i).neighbors()) {
+            if (i < neighbor) {
+                edge_ends.push_back(map.at(i));
+                edge_ends.push_back(map.at(neighbor));
+            }
+        }
+    }
+    CsrGraph result;
+    result.assign_from_edge_list(graph.num_nodes(), edge_ends.data(), edge_ends.size() / 2);
+    return result;
+}
+
+/**
+ * Runs the algorithm of one member.
+ * @return Whether the algorithm ran to completion, then result holds the mate array in the node ids of the graph
+ */
+template<typename GraphT>
+bool run_member(GraphT const& graph, SolverConfig const& config, CancellationToken const& cancellation,
+                PortfolioResult& result) {
+    MaximumMatchingAlgorithm<GraphT> algorithm(graph, config);
+    algorithm.set_cancellation_token(&cancellation);
+    auto const& matching_edges = algorithm.calc_maximum_matching();
+    if (algorithm.was_cancelled()) {
+        return false;
+    }
+    result.mates.assign(graph.num_nodes(), MatchingSolver::unmatched);
+    for (auto const&[end_a, end_b] : matching_edges) {
+        result.mates.at(end_a) = end_b;
+        result.mates.at(end_b) = end_a;
+    }
+    result.matching_size = matching_edges.size();
+    result.statistics = algorithm.statistics();
+    return true;
+}
+
+} // end of anonymous namespace
+
+EdgeList PortfolioResult::matching_edges() const {
+    EdgeList result;
+    result.reserve(matching_size);
+    for (NodeId i = 0; i < mates.size(); ++i) {
+        if (mates.at(i) != MatchingSolver::unmatched and i < mates.at(i)) {
+            result.emplace_back(i, mates.at(i));
+        }
+    }
+    return result;
+}
+
+PortfolioSolver::PortfolioSolver(std::vector<PortfolioMember> members) : _members(std::move(members)) {
+    if (_members.empty()) {
+        throw std::runtime_error("A portfolio needs at least one member");
+    }
+}
+
+std::vector<PortfolioMember> PortfolioSolver::default_members(size_t num_members, SolverConfig const& config) {
+    std::vector<PortfolioMember> result{{config, std::nullopt}};
+    for (size_t i = 1; i < num_members; ++i) {
+        auto member_config = config;
+        member_config.seed = config.seed + i;
+        member_config.tree_search = static_cast<TreeSearch>((static_cast<size_t>(config.tree_search) + i) % 3);
+        result.push_back({member_config, member_config.seed});
+    }
+    return result;
+}
+
+PortfolioResult PortfolioSolver::solve(Graph const& graph) const {
+    return solve_impl(graph);
+}
+
+PortfolioResult PortfolioSolver::solve(CsrGraphView const& graph) const {
+    return solve_impl(graph);
+}
+
+PortfolioResult PortfolioSolver::solve(CompressedGraph const& graph) const {
+    return solve_impl(graph);
+}
+
+template<typename GraphT>
+PortfolioResult PortfolioSolver::solve_impl(GraphT const& graph) const {
+    auto const& start = Clock::now();
+    CancellationToken cancellation;
+    std::atomic<bool> has_winner{false};
+    PortfolioResult result;
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+
+    auto const& race = [&](size_t index) {
+        try {
+            auto const& member = _members.at(index);
+            PortfolioResult member_result;
+            bool finished;
+            std::vector<NodeId> map;
+            if (member.shuffle_seed) {
+                map = Graph::shuffle_map(graph.num_nodes(), *member.shuffle_seed);
+                auto const& shuffled = renumbered(graph, map);
+                finished = run_member(shuffled.view(), member.config, cancellation, member_result);
+            } else {
+                finished = run_member(graph, member.config, cancellation, member_result);
+            }
+            // Only the first member to finish may write the result, the others have been cancelled by then
+            if (not finished or has_winner.exchange(true)) {
+                return;
+            }
+            cancellation.cancel();
+            result = std::move(member_result);
+            result.winner = index;
+            result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (member.shuffle_seed) {
+                // Node i of the original graph is node map[i] of the shuffled one
+                std::vector<NodeId> inverse(map.size());
+                for (NodeId i = 0; i < map.size(); ++i) {
+                    inverse.at(map.at(i)) = i;
+                }
+                auto const shuffled_mates = std::move(result.mates);
+                result.mates.assign(shuffled_mates.size(), MatchingSolver::unmatched);
+                for (NodeId i = 0; i < map.size(); ++i) {
+                    auto const& shuffled_mate = shuffled_mates.at(map.at(i));
+                    if (shuffled_mate != MatchingSolver::unmatched) {
+                        result.mates.at(i) = inverse.at(shuffled_mate);
+                    }
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (not first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < _members.size(); ++i) {
+        threads.emplace_back(race, i);
+    }
+    // The calling thread takes part in the race as well
+    race(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (not has_winner) {
+        std::rethrow_exception(first_error);
+    }
+    return result;
+}
@@ -0,0 +1,67 @@
+#ifndef MAXMATCHING_PORTFOLIO_SOLVER_H
+#define MAXMATCHING_PORTFOLIO_SOLVER_H
+
+#include <optional>
+#include <vector>
+#include "graph.h"
+#include "csr_graph.h"
+#include "compressed_graph.h"
+#include "solver_config.h"
+#include "solver_statistics.h"
+
+/**
+ * One member of a portfolio: the solver settings and the node numbering it runs on.
+ */
+struct PortfolioMember {
+    SolverConfig config;
+    /// Run on the graph renumbered by Graph::shuffle_map with this seed, on the original numbering if empty
+    std::optional<unsigned long> shuffle_seed;
+};
+
+struct PortfolioResult {
+    /// Mate array in the original node ids, in the format of MatchingSolver
+    std::vector<NodeId> mates;
+    size_t matching_size = 0;
+    /// Index of the member whose matching is returned
+    size_t winner = 0;
+    /// Statistics of the winner
+    SolverStatistics statistics;
+    /// Seconds from the start of the race until the winner finished
+    double seconds = 0;
+
+    /// @return The edges of the matching in the original node ids, with the smaller end first
+    [[nodiscard]] EdgeList matching_edges() const;
+};
+
+/**
+ * Races several solver settings on the same graph, one thread per member. The running time on a graph depends a lot
+ * on the node order and the search strategy, while the result is a maximum matching either way. So the first member
+ * to finish has proven optimality and wins, the others are cancelled cooperatively (see CancellationToken) and the
+ * winning matching is mapped back to the original node ids.
+ *
+ * Every member with a shuffle seed works on its own renumbered CSR copy of the graph, built by its thread.
+ */
+class PortfolioSolver {
+public:
+    explicit PortfolioSolver(std::vector<PortfolioMember> members);
+
+    /**
+     * @return num_members members: The given settings on the original numbering, then shuffled numberings (with
+     * seeds config.seed + 1, ...) cycling through the tree search orders.
+     */
+    static std::vector<PortfolioMember> default_members(size_t num_members, SolverConfig const& config);
+
+    PortfolioResult solve(Graph const& graph) const;
+
+    PortfolioResult solve(CsrGraphView const& graph) const;
+
+    PortfolioResult solve(CompressedGraph const& graph) const;
+
+private:
+    template<typename GraphT>
+    PortfolioResult solve_impl(GraphT const& graph) const;
+
+    std::vector<PortfolioMember> _members;
+};
+
+#endif //MAXMATCHING_PORTFOLIO_SOLVER_H
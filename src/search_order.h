@@ -0,0 +1,171 @@
+#ifndef MAXMATCHING_SEARCH_ORDER_H
+#define MAXMATCHING_SEARCH_ORDER_H
+
+#include <deque>
+#include <variant>
+#include <vector>
+#include "graph.h"
+
+/**
+ * Pending work while growing an alternating tree: Either an even node whose edges have not been listed yet or the
+ * remaining edges of an even node.
+ *
+ * The classes below are the search order policies of PerfectMatchingAlgorithm. They store these entries and decide
+ * which one the next edge is taken from. Edges of the current entry are always scanned before switching to another
+ * one. All policies provide:
+ * - push(entry): Add an entry for a node that just became even
+ * - current(): The entry the next edge is taken from. Must not be called when empty
+ * - pop_current(): Remove the current entry once it has no edges left
+ * - empty(), clear()
+ */
+using SearchEntry = std::variant<EdgeList, NodeId>;
+
+/**
+ * Always continue at the node that most recently became even. This tends to find long augmenting paths, but needs the
+ * least memory.
+ */
+class DepthFirstOrder {
+public:
+    void push(SearchEntry entry);
+
+    [[nodiscard]] SearchEntry& current();
+
+    void pop_current();
+
+    [[nodiscard]] bool empty() const;
+
+    void clear();
+
+private:
+    std::vector<SearchEntry> _entries;
+};
+
+/**
+ * Scan nodes in the order they became even, so augmenting paths are found in order of (shrunken) length.
+ */
+class BreadthFirstOrder {
+public:
+    void push(SearchEntry entry);
+
+    [[nodiscard]] SearchEntry& current();
+
+    void pop_current();
+
+    [[nodiscard]] bool empty() const;
+
+    void clear();
+
+private:
+    std::deque<SearchEntry> _entries;
+};
+
+/**
+ * Depth first search that does not descend more than max_depth even nodes at once. Deeper nodes are deferred to a
+ * queue and each starts a new depth first search once everything above them has been scanned.
+ */
+template<unsigned max_depth>
+class BoundedDepthFirstOrder {
+public:
+    void push(SearchEntry entry);
+
+    [[nodiscard]] SearchEntry& current();
+
+    void pop_current();
+
+    [[nodiscard]] bool empty() const;
+
+    void clear();
+
+private:
+    struct DepthEntry {
+        SearchEntry entry;
+        unsigned depth;
+    };
+
+    std::vector<DepthEntry> _stack;
+    std::deque<SearchEntry> _deferred;
+    /// Depth of the entry returned by the last call to current, new entries are one level deeper
+    unsigned _current_depth = 0;
+};
+
+using HybridOrder = BoundedDepthFirstOrder<8>;
+
+//Inline section
+
+inline void DepthFirstOrder::push(SearchEntry entry) {
+    _entries.push_back(std::move(entry));
+}
+
+inline SearchEntry& DepthFirstOrder::current() {
+    return _entries.back();
+}
+
+inline void DepthFirstOrder::pop_current() {
+    _entries.pop_back();
+}
+
+inline bool DepthFirstOrder::empty() const {
+    return _entries.empty();
+}
+
+inline void DepthFirstOrder::clear() {
+    _entries.clear();
+}
+
+inline void BreadthFirstOrder::push(SearchEntry entry) {
+    _entries.push_back(std::move(entry));
+}
+
+inline SearchEntry& BreadthFirstOrder::current() {
+    return _entries.front();
+}
+
+inline void BreadthFirstOrder::pop_current() {
+    _entries.pop_front();
+}
+
+inline bool BreadthFirstOrder::empty() const {
+    return _entries.empty();
+}
+
+inline void BreadthFirstOrder::clear() {
+    _entries.clear();
+}
+
+template<unsigned max_depth>
+void BoundedDepthFirstOrder<max_depth>::push(SearchEntry entry) {
+    if (_current_depth < max_depth) {
+        _stack.push_back({std::move(entry), _current_depth + 1});
+    } else {
+        _deferred.push_back(std::move(entry));
+    }
+}
+
+template<unsigned max_depth>
+SearchEntry& BoundedDepthFirstOrder<max_depth>::current() {
+    if (_stack.empty()) {
+        _stack.push_back({std::move(_deferred.front()), 1});
+        _deferred.pop_front();
+    }
+    _current_depth = _stack.back().depth;
+    return _stack.back().entry;
+}
+
+template<unsigned max_depth>
+void BoundedDepthFirstOrder<max_depth>::pop_current() {
+    _stack.pop_back();
+}
+
+template<unsigned max_depth>
+bool BoundedDepthFirstOrder<max_depth>::empty() const {
+    return _stack.empty() and _deferred.empty();
+}
+
+template<unsigned max_depth>
+void BoundedDepthFirstOrder<max_depth>::clear() {
+    _stack.clear();
+    _deferred.clear();
+    _current_depth = 0;
+}
+
+#endif //MAXMATCHING_SEARCH_ORDER_H
@@ -0,0 +1,148 @@
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+#include "semi_streaming_matching.h"
+#include "dimacs_edge_stream.h"
+
+SemiStreamingMatching::SemiStreamingMatching(std::string file_name, Config const& config)
+        : _file_name(std::move(file_name)),
+          _config(config),
+          _read_buffer(std::max<size_t>(_config.buffer_bytes, 1)),
+          _current_matching(read_num_nodes(_file_name)) {
+    if (_config.candidates_per_vertex == 0) {
+        throw std::runtime_error("Semi-streaming matching needs at least one candidate per vertex");
+    }
+}
+
+EdgeList SemiStreamingMatching::calc_matching() {
+    greedy_pass();
+    auto const& num_nodes = _current_matching.total_num_nodes();
+    _candidates.resize(num_nodes * _config.candidates_per_vertex);
+    // Non-zero until a pass proves that there is nothing left to augment
+    size_t augmentations = 1;
+    while (augmentations > 0 and _report.passes < _config.max_passes) {
+        augmentations = augmenting_pass();
+    }
+    // Only a pass that did not change the matching saw every exposed neighbor of the final matching
+    _report.no_short_augmenting_paths = augmentations == 0 and _config.candidates_per_vertex >= 2;
+
+    auto matching_edges = _current_matching.get_matching_edges();
+    _report.matching_size = matching_edges.size();
+    // A maximal matching is a 1/2-approximation, a matching without augmenting paths of length 3 a 2/3-approximation
+    auto const& ratio_bound = _report.no_short_augmenting_paths ? 3 * _report.matching_size / 2
+                                                                : 2 * _report.matching_size;
+    _report.upper_bound = std::min(num_nodes / 2, ratio_bound);
+    return matching_edges;
+}
+
+SemiStreamingMatching::Report const& SemiStreamingMatching::report() const {
+    return _report;
+}
+
+NodeId SemiStreamingMatching::num_nodes() const {
+    return _current_matching.total_num_nodes();
+}
+
+NodeId SemiStreamingMatching::read_num_nodes(std::string const& file_name) {
+    std::ifstream input(file_name);
+    if (not input) {
+        throw std::runtime_error("Failed to open " + file_name);
+    }
+    return DimacsEdgeStream(input).num_nodes();
+}
+
+template<typename EdgeCallback>
+void SemiStreamingMatching::make_pass(EdgeCallback&& on_edge) {
+    std::ifstream input;
+    // The buffer needs to be set before opening the file to have an effect
+    input.rdbuf()->pubsetbuf(_read_buffer.data(), static_cast<std::streamsize>(_read_buffer.size()));
+    input.open(_file_name);
+    if (not input) {
+        throw std::runtime_error("Failed to open " + _file_name);
+    }
+    DimacsEdgeStream edges(input);
+    assert(edges.num_nodes() == _current_matching.total_num_nodes());
+    while (auto const& edge = edges.next_edge()) {
+        on_edge(edge->first, edge->second);
+    }
+    ++_report.passes;
+}
+
+void SemiStreamingMatching::greedy_pass() {
+    make_pass([this](NodeId end_a, NodeId end_b) {
+        if (end_a != end_b
+            and not _current_matching.is_matched(Representative(end_a))
+            and not _current_matching.is_matched(Representative(end_b))) {
+            _current_matching.add_edge(end_a, end_b);
+        }
+    });
+}
+
+size_t SemiStreamingMatching::augmenting_pass() {
+    std::fill(_candidates.begin(), _candidates.end(), invalid_node);
+    make_pass([this](NodeId end_a, NodeId end_b) {
+        auto const& a_matched = _current_matching.is_matched(Representative(end_a));
+        auto const& b_matched = _current_matching.is_matched(Representative(end_b));
+        // The greedy matching is maximal and augmentations never expose a vertex, so there are no edges between two
+        // exposed vertices
+        assert(a_matched or b_matched or end_a == end_b);
+        if (a_matched and not b_matched) {
+            add_candidate(end_a, end_b);
+        } else if (b_matched and not a_matched) {
+            add_candidate(end_b, end_a);
+        }
+    });
+    size_t augmentations = 0;
+    for (NodeId node_a = 0; node_a < _current_matching.total_num_nodes(); ++node_a) {
+        Representative repr_a(node_a);
+        if (not _current_matching.is_matched(repr_a)) {
+            continue;
+        }
+        auto const& node_b = _current_matching.other_end(repr_a).id();
+        if (node_b < node_a) {
+            continue;
+        }
+        // Try every exposed candidate of a, any exposed candidate of b different from it closes the path
+        for (size_t slot = 0; slot < _config.candidates_per_vertex; ++slot) {
+            auto const& exposed_a = _candidates.at(node_a * _config.candidates_per_vertex + slot);
+            if (exposed_a == invalid_node or _current_matching.is_matched(Representative(exposed_a))) {
+                continue;
+            }
+            auto const& exposed_b = find_exposed_candidate(node_b, exposed_a);
+            if (exposed_b != invalid_node) {
+                _current_matching.augment_along(
+                        {Representative(exposed_a), repr_a, Representative(node_b), Representative(exposed_b)},
+                        {{exposed_a, node_a}, {node_a, node_b}, {node_b, exposed_b}}
+                );
+                ++augmentations;
+                break;
+            }
+        }
+    }
+    return augmentations;
+}
+
+void SemiStreamingMatching::add_candidate(NodeId matched, NodeId exposed) {
+    auto const& begin = _candidates.begin() + matched * _config.candidates_per_vertex;
+    auto const& end = begin + _config.candidates_per_vertex;
+    auto const& free_slot = std::find(begin, end, invalid_node);
+    if (free_slot != end and std::find(begin, free_slot, exposed) == free_slot) {
+        *free_slot = exposed;
+    }
+}
+
+NodeId SemiStreamingMatching::find_exposed_candidate(NodeId node, NodeId excluded) const {
+    for (size_t slot = 0; slot < _config.candidates_per_vertex; ++slot) {
+        auto const& candidate = _candidates.at(node * _config.candidates_per_vertex + slot);
+        if (candidate != invalid_node and candidate != excluded
+            and not _current_matching.is_matched(Representative(candidate))) {
+            return candidate;
+        }
+    }
+    return invalid_node;
+}
+
+double SemiStreamingMatching::Report::approximation_ratio() const {
+    return upper_bound == 0 ? 1. : static_cast<double>(matching_size) / static_cast<double>(upper_bound);
+}
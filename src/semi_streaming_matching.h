@@ -0,0 +1,79 @@
+#ifndef MAXMATCHING_SEMI_STREAMING_MATCHING_H
+#define MAXMATCHING_SEMI_STREAMING_MATCHING_H
+
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "matching.h"
+
+/**
+ * Approximate maximum matching for graphs whose edges do not fit into memory. The DIMACS file is read sequentially
+ * several times, only the matching (O(n)) and small per-pass buffers are kept in memory:
+ * - The first pass builds a greedy maximal matching.
+ * - Every further pass collects, for each matched vertex, a few exposed neighbors and then augments along disjoint
+ * augmenting paths of length 3 (exposed - matched - matched - exposed).
+ * Once a pass finds no augmenting path of length 3 the matching is a 2/3-approximation.
+ */
+class SemiStreamingMatching {
+public:
+    struct Config {
+        /// Size of the read buffer used for each pass over the input
+        size_t buffer_bytes = 1 << 20;
+        /// Number of exposed neighbors remembered per vertex during an augmenting pass. Uses
+        /// candidates_per_vertex * sizeof(NodeId) bytes per node, at least 2 are needed to certify that no augmenting
+        /// paths of length 3 are left
+        size_t candidates_per_vertex = 2;
+        /// Maximum number of passes over the input, including the initial greedy pass
+        size_t max_passes = 16;
+    };
+
+    struct Report {
+        size_t passes = 0;
+        size_t matching_size = 0;
+        /// Upper bound on the size of a maximum matching derived from the properties of the final matching
+        size_t upper_bound = 0;
+        /// Whether the last pass certified that no augmenting path of length at most 3 exists
+        bool no_short_augmenting_paths = false;
+
+        [[nodiscard]] double approximation_ratio() const;
+    };
+
+    SemiStreamingMatching(std::string file_name, Config const& config);
+
+    [[nodiscard]] EdgeList calc_matching();
+
+    [[nodiscard]] Report const& report() const;
+
+    [[nodiscard]] NodeId num_nodes() const;
+
+private:
+    static auto constexpr invalid_node = std::numeric_limits<NodeId>::max();
+
+    [[nodiscard]] static NodeId read_num_nodes(std::string const& file_name);
+
+    /// Reads all edges of the input once, calling on_edge for each of them
+    template<typename EdgeCallback>
+    void make_pass(EdgeCallback&& on_edge);
+
+    void greedy_pass();
+
+    /// @return The number of augmentations performed
+    size_t augmenting_pass();
+
+    /// Records exposed as a candidate endpoint of an augmenting path through the matched vertex matched
+    void add_candidate(NodeId matched, NodeId exposed);
+
+    /// @return An exposed candidate of node different from excluded, or invalid_node if none exists
+    [[nodiscard]] NodeId find_exposed_candidate(NodeId node, NodeId excluded) const;
+
+    std::string const _file_name;
+    Config const _config;
+    std::vector<char> _read_buffer;
+    Matching _current_matching;
+    /// candidates_per_vertex slots per node, unused slots are invalid_node
+    std::vector<NodeId> _candidates;
+    Report _report;
+};
+
+
+#endif //MAXMATCHING_SEMI_STREAMING_MATCHING_H
@@ -0,0 +1,40 @@
+#ifndef MAXMATCHING_SOLVER_CONFIG_H
+#define MAXMATCHING_SOLVER_CONFIG_H
+
+/**
+ * Order in which PerfectMatchingAlgorithm picks the roots of its alternating trees among the uncovered vertices.
+ * This does not affect correctness, but changes which trees are grown and thus how much blossom shrinking happens.
+ */
+enum class RootOrder {
+    /// Increasing node id
+    by_id,
+    /// Increasing degree, ties broken by id
+    min_degree,
+    /// Decreasing degree, ties broken by id
+    max_degree,
+    /// Uniformly random, see SolverConfig::seed
+    random,
+};
+
+/**
+ * Order in which the edges of even tree nodes are scanned while growing an alternating tree, see search_order.h. The
+ * choice is made once per solve, the tree growth itself is specialized for each order at compile time.
+ */
+enum class TreeSearch {
+    depth_first,
+    breadth_first,
+    /// Depth first up to a fixed depth, deeper nodes are scanned breadth first
+    hybrid,
+};
+
+/**
+ * Runtime settings of the matching algorithms that do not affect the result, only the way it is found.
+ */
+struct SolverConfig {
+    RootOrder root_order = RootOrder::by_id;
+    TreeSearch tree_search = TreeSearch::depth_first;
+    /// Seed for all randomized choices
+    unsigned long seed = 0;
+};
+
+#endif //MAXMATCHING_SOLVER_CONFIG_H
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "solver_daemon.h"
+
+using namespace daemon_protocol;
+
+namespace {
+
+Response error_response(std::string const& message) {
+    Response response;
+    response.status = Status::error;
+    response.payload.assign(message.begin(), message.end());
+    return response;
+}
+
+Response matching_response(MatchingSolver const& solver) {
+    Response response;
+    std::uint64_t const matching_size = solver.matching_size();
+    response.payload.reserve(sizeof(matching_size) + solver.mates().size() * sizeof(NodeId));
+    append_to_payload(response.payload, &matching_size, 1);
+    append_to_payload(response.payload, solver.mates().data(), solver.mates().size());
+    return response;
+}
+
+} // end of anonymous namespace
+
+SolverDaemon::Connection::Connection(int fd) : fd(fd) {}
+
+SolverDaemon::Connection::~Connection() {
+    ::close(fd);
+}
+
+SolverDaemon::SolverDaemon(std::string socket_path, size_t num_workers)
+        : _socket_path(std::move(socket_path)), _num_workers(std::max<size_t>(num_workers, 1)) {}
+
+SolverDaemon::~SolverDaemon() {
+    if (_listen_fd >= 0) {
+        ::close(_listen_fd);
+        ::unlink(_socket_path.c_str());
+    }
+}
+
+NodeId SolverDaemon::load_graph(std::string const& name, std::string const& file_name) {
+    std::ifstream input(file_name, std::ios::binary);
+    if (not input) {
+        throw std::runtime_error("Failed to open " + file_name);
+    }
+    auto graph = std::make_shared<CsrGraph>();
+    if (CsrGraph::is_snapshot(input)) {
+        *graph = CsrGraph::read_snapshot(input);
+    } else {
+        graph->assign_from_graph(Graph::read_dimacs(input));
+    }
+    auto const& num_nodes = graph->view().num_nodes();
+    std::lock_guard lock(_graphs_mutex);
+    _graphs[name] = std::move(graph);
+    return num_nodes;
+}
+
+void SolverDaemon::run() {
+    _listen_fd = listen_on(_socket_path);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < _num_workers; ++i) {
+        workers.emplace_back(&SolverDaemon::serve_jobs, this);
+    }
+    accept_connections();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    // Wake up readers blocked on their connection and wait for them to exit
+    std::unique_lock lock(_connections_mutex);
+    for (auto const& weak_connection : _connections) {
+        if (auto const& connection = weak_connection.lock()) {
+            ::shutdown(connection->fd, SHUT_RDWR);
+        }
+    }
+    _readers_finished.wait(lock, [this]() { return _num_active_readers == 0; });
+}
+
+void SolverDaemon::accept_connections() {
+    while (not _stopping) {
+        int const fd = ::accept(_listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (_stopping) {
+                break;
+            } else if (errno == EINTR or errno == ECONNABORTED) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Failed to accept connection: ") + std::strerror(errno));
+        }
+        auto connection = std::make_shared<Connection>(fd);
+        std::lock_guard lock(_connections_mutex);
+        _connections.erase(
+                std::remove_if(_connections.begin(), _connections.end(), [](auto const& weak_connection) {
+                    return weak_connection.expired();
+                }),
+                _connections.end()
+        );
+        _connections.push_back(connection);
+        ++_num_active_readers;
+        std::thread(&SolverDaemon::read_requests, this, std::move(connection)).detach();
+    }
+}
+
+void SolverDaemon::read_requests(std::shared_ptr<Connection> const& connection) {
+    try {
+        Request request;
+        while (not _stopping and read_request(connection->fd, request)) {
+            std::lock_guard lock(_jobs_mutex);
+            _jobs.push_back({connection, std::move(request)});
+            _jobs_changed.notify_one();
+        }
+    } catch (std::exception const& xcp) {
+        if (not _stopping) {
+            std::cerr << "Dropping connection: " << xcp.what() << '\n';
+        }
+    }
+    std::lock_guard lock(_connections_mutex);
+    --_num_active_readers;
+    _readers_finished.notify_all();
+}
+
+void SolverDaemon::serve_jobs() {
+    // Each worker keeps its own solver, so buffers are reused across the requests it serves
+    MatchingSolver solver;
+    while (true) {
+        std::unique_lock lock(_jobs_mutex);
+        _jobs_changed.wait(lock, [this]() { return _stopping or not _jobs.empty(); });
+        if (_stopping) {
+            return;
+        }
+        auto job = std::move(_jobs.front());
+        _jobs.pop_front();
+        lock.unlock();
+
+        Response response;
+        try {
+            response = handle(job.request, solver);
+        } catch (std::exception const& xcp) {
+            response = error_response(xcp.what());
+        }
+        response.request_id = job.request.request_id;
+        try {
+            std::lock_guard write_lock(job.connection->write_mutex);
+            write_response(job.connection->fd, response);
+        } catch (std::exception const& xcp) {
+            std::cerr << "Failed to send response: " << xcp.what() << '\n';
+        }
+    }
+}
+
+Response SolverDaemon::handle(Request const& request, MatchingSolver& solver) {
+    switch (request.type) {
+        case RequestType::load_graph: {
+            std::uint64_t const num_nodes = load_graph(
+                    request.graph_name, std::string(request.payload.begin(), request.payload.end())
+            );
+            Response response;
+            append_to_payload(response.payload, &num_nodes, 1);
+            return response;
+        }
+        case RequestType::solve: {
+            auto const& graph = find_graph(request.graph_name);
+            solver.solve(graph->view());
+            return matching_response(solver);
+        }
+        case RequestType::warm_start: {
+            auto const& graph = find_graph(request.graph_name);
+            solver.solve_warm_start(graph->view(), read_from_payload<NodeId>(request.payload));
+            return matching_response(solver);
+        }
+        case RequestType::subgraph: {
+            auto const& graph = find_graph(request.graph_name);
+            std::vector<char> vertex_mask(graph->view().num_nodes(), false);
+            for (auto const& vertex : read_from_payload<NodeId>(request.payload)) {
+                if (vertex >= vertex_mask.size()) {
+                    return error_response("Subgraph vertex out of range");
+                }
+                vertex_mask.at(vertex) = true;
+            }
+            solver.solve_subgraph(graph->view(), vertex_mask);
+            return matching_response(solver);
+        }
+        case RequestType::unload_graph: {
+            std::lock_guard lock(_graphs_mutex);
+            if (_graphs.erase(request.graph_name) == 0) {
+                return error_response("Unknown graph " + request.graph_name);
+            }
+            return {};
+        }
+        case RequestType::shutdown:
+            stop();
+            return {};
+    }
+    return error_response("Unknown request type");
+}
+
+std::shared_ptr<CsrGraph const> SolverDaemon::find_graph(std::string const& name) const {
+    std::lock_guard lock(_graphs_mutex);
+    auto const& it = _graphs.find(name);
+    if (it == _graphs.end()) {
+        throw std::runtime_error("Unknown graph " + name);
+    }
+    return it->second;
+}
+
+void SolverDaemon::stop() {
+    {
+        std::lock_guard lock(_jobs_mutex);
+        _stopping = true;
+    }
+    _jobs_changed.notify_all();
+    // Makes the blocking accept call in accept_connections return
+    ::shutdown(_listen_fd, SHUT_RDWR);
+}
@@ -0,0 +1,88 @@
+#ifndef MAXMATCHING_SOLVER_DAEMON_H
+#define MAXMATCHING_SOLVER_DAEMON_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "daemon_protocol.h"
+#include "matching_solver.h"
+
+/**
+ * Long-running solver process answering requests over a Unix domain socket (see daemon_protocol.h). Graphs are loaded
+ * once under a name and stay resident. Each connection has a reader thread which puts complete requests into a queue,
+ * the queue is served by a pool of workers that each own a reusable MatchingSolver.
+ */
+class SolverDaemon {
+public:
+    SolverDaemon(std::string socket_path, size_t num_workers);
+
+    ~SolverDaemon();
+
+    /**
+     * Loads a graph from a DIMACS file or a graph snapshot (see CsrGraph::write_snapshot) and makes it available
+     * under the given name, replacing any graph previously loaded under that name.
+     * @return The number of nodes of the loaded graph
+     */
+    NodeId load_graph(std::string const& name, std::string const& file_name);
+
+    /**
+     * Serves requests until a shutdown request is received.
+     */
+    void run();
+
+private:
+    struct Connection {
+        explicit Connection(int fd);
+
+        ~Connection();
+
+        int const fd;
+        /// Workers answering requests of the same connection must not interleave their responses
+        std::mutex write_mutex;
+    };
+
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        daemon_protocol::Request request;
+    };
+
+    void accept_connections();
+
+    void read_requests(std::shared_ptr<Connection> const& connection);
+
+    void serve_jobs();
+
+    [[nodiscard]] daemon_protocol::Response handle(daemon_protocol::Request const& request, MatchingSolver& solver);
+
+    [[nodiscard]] std::shared_ptr<CsrGraph const> find_graph(std::string const& name) const;
+
+    void stop();
+
+    std::string const _socket_path;
+    size_t const _num_workers;
+    int _listen_fd = -1;
+    std::atomic<bool> _stopping = false;
+
+    mutable std::mutex _graphs_mutex;
+    /// Requests in flight keep their graph alive, so unloading or replacing a graph never blocks on solves
+    std::map<std::string, std::shared_ptr<CsrGraph const>> _graphs;
+
+    std::mutex _jobs_mutex;
+    std::condition_variable _jobs_changed;
+    std::deque<Job> _jobs;
+
+    std::mutex _connections_mutex;
+    std::condition_variable _readers_finished;
+    std::vector<std::weak_ptr<Connection>> _connections;
+    /// Reader threads are detached, shutdown waits for this to drop to zero instead of joining them
+    size_t _num_active_readers = 0;
+};
+
+
+#endif //MAXMATCHING_SOLVER_DAEMON_H
@@ -0,0 +1,23 @@
+#ifndef MAXMATCHING_SOLVER_PROGRESS_H
+#define MAXMATCHING_SOLVER_PROGRESS_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Snapshot of a running solve, passed to the progress callback of MaximumMatchingAlgorithm.
+ */
+struct SolverProgress {
+    /// Edges in the current matching
+    size_t matching_size = 0;
+    /// No matching of the graph has more edges than this
+    size_t upper_bound = 0;
+    /// Seconds since the solve started
+    double seconds = 0;
+    /// Matching edges gained per second since the previous report
+    double edges_per_second = 0;
+};
+
+using ProgressCallback = std::function<void(SolverProgress const&)>;
+
+#endif //MAXMATCHING_SOLVER_PROGRESS_H
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <ostream>
+#include "solver_statistics.h"
+
+void SolverStatistics::record_tree(size_t num_vertices, bool augmented) {
+    ++trees_grown;
+    if (augmented) {
+        ++augmentations;
+    } else {
+        ++frustrated_trees;
+    }
+    total_tree_vertices += num_vertices;
+    max_tree_vertices = std::max(max_tree_vertices, num_vertices);
+}
+
+void SolverStatistics::record_augmenting_path(size_t length) {
+    total_augmenting_path_length += length;
+    max_augmenting_path_length = std::max(max_augmenting_path_length, length);
+    size_t bucket = 0;
+    while ((length >> (bucket + 1)) > 0) {
+        ++bucket;
+    }
+    if (augmenting_path_histogram.size() <= bucket) {
+        augmenting_path_histogram.resize(bucket + 1);
+    }
+    ++augmenting_path_histogram.at(bucket);
+}
+
+void SolverStatistics::record_nesting_depth(size_t depth) {
+    max_nesting_depth = std::max(max_nesting_depth, depth);
+}
+
+void SolverStatistics::print(std::ostream& output) const {
+    if (counters_enabled) {
+        auto const& average_tree_vertices = trees_grown == 0 ? 0. : static_cast<double>(total_tree_vertices)
+                                                                    / static_cast<double>(trees_grown);
+        auto const& average_path_length = augmentations == 0 ? 0. : static_cast<double>(total_augmenting_path_length)
+                                                                    / static_cast<double>(augmentations);
+        output << "Trees grown: " << trees_grown << " (" << augmentations << " augmenting, " << frustrated_trees
+               << " frustrated)\n"
+               << "Tree vertices: " << average_tree_vertices << " on average, " << max_tree_vertices << " at most\n"
+               << "Edges scanned: " << edges_scanned << ", extends: " << extends << '\n'
+               << "Blossoms shrunk: " << shrinks << ", nested at most " << max_nesting_depth << " deep\n"
+               << "Augmenting path length: " << average_path_length << " on average, "
+               << max_augmenting_path_length << " at most\n"
+               << "Blocked vertices: " << blocked_vertices << '\n';
+    } else {
+        output << "Solver counters are disabled (built without MAXMATCHING_STATISTICS)\n";
+    }
+    output << "Leaf matching time: " << leaves_seconds << " s\n"
+           << "Exact search time: " << exact_seconds << " s\n";
+}
+
+void SolverStatistics::write_json(std::ostream& output) const {
+    output << "{\"counters_enabled\": " << (counters_enabled ? "true" : "false")
+           << ", \"trees_grown\": " << trees_grown
+           << ", \"augmentations\": " << augmentations
+           << ", \"frustrated_trees\": " << frustrated_trees
+           << ", \"total_tree_vertices\": " << total_tree_vertices
+           << ", \"max_tree_vertices\": " << max_tree_vertices
+           << ", \"edges_scanned\": " << edges_scanned
+           << ", \"extends\": " << extends
+           << ", \"shrinks\": " << shrinks
+           << ", \"max_nesting_depth\": " << max_nesting_depth
+           << ", \"total_augmenting_path_length\": " << total_augmenting_path_length
+           << ", \"max_augmenting_path_length\": " << max_augmenting_path_length
+           << ", \"augmenting_path_histogram\": [";
+    for (size_t i = 0; i < augmenting_path_histogram.size(); ++i) {
+        output << (i > 0 ? ", " : "") << "{\"min_length\": " << (size_t(1) << i) << ", \"count\": "
+               << augmenting_path_histogram.at(i) << "}";
+    }
+    output << "], \"blocked_vertices\": " << blocked_vertices
+           << ", \"phase_seconds\": {\"parse\": " << parse_seconds << ", \"leaves\": " << leaves_seconds
+           << ", \"exact\": " << exact_seconds << "}}";
+}
@@ -0,0 +1,65 @@
+#ifndef MAXMATCHING_SOLVER_STATISTICS_H
+#define MAXMATCHING_SOLVER_STATISTICS_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+/**
+ * Counters and phase timings collected while computing a maximum matching.
+ *
+ * The counters are incremented by the classes of the algorithm (PerfectMatchingAlgorithm, AlternatingTree,
+ * NestedShrinking, Matching) if they were given a pointer to a SolverStatistics object. The increments are only
+ * compiled in if MAXMATCHING_STATISTICS is defined (CMake option of the same name), otherwise all counters stay 0.
+ * The phase timings are always collected.
+ */
+struct SolverStatistics {
+#ifdef MAXMATCHING_STATISTICS
+    static bool constexpr counters_enabled = true;
+#else
+    static bool constexpr counters_enabled = false;
+#endif
+
+    /// Number of alternating trees grown, each either augments or is frustrated
+    size_t trees_grown = 0;
+    size_t augmentations = 0;
+    size_t frustrated_trees = 0;
+    /// Sum of the number of vertices over all trees
+    size_t total_tree_vertices = 0;
+    size_t max_tree_vertices = 0;
+    /// Edges of even tree nodes considered while growing trees
+    size_t edges_scanned = 0;
+    /// Number of times a tree was extended by a matching edge
+    size_t extends = 0;
+    /// Number of blossoms shrunk
+    size_t shrinks = 0;
+    /// Largest number of blossoms nested into each other at any time
+    size_t max_nesting_depth = 0;
+    /// Sum and maximum of the augmenting path lengths, measured in edges of the shrunken graph
+    size_t total_augmenting_path_length = 0;
+    size_t max_augmenting_path_length = 0;
+    /// Entry i is the number of augmenting paths with a length in [2^i, 2^(i + 1))
+    std::vector<size_t> augmenting_path_histogram;
+    /// Vertices removed from the search, both by leaf matching and as part of frustrated trees
+    size_t blocked_vertices = 0;
+    /// Time spent reading the graph (only set by callers that do the parsing), in leaf matching (preprocessing) and
+    /// in the exact search
+    double parse_seconds = 0;
+    double leaves_seconds = 0;
+    double exact_seconds = 0;
+
+    /// Records a finished tree with the given number of vertices
+    void record_tree(size_t num_vertices, bool augmented);
+
+    void record_augmenting_path(size_t length);
+
+    void record_nesting_depth(size_t depth);
+
+    /// Human readable summary
+    void print(std::ostream& output) const;
+
+    /// Writes all values as a single line JSON object
+    void write_json(std::ostream& output) const;
+};
+
+#endif //MAXMATCHING_SOLVER_STATISTICS_H
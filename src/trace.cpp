@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "trace.h"
+
+namespace trace {
+
+struct Event {
+    char const* name;
+    char const* arg_name;
+    std::int64_t arg_value;
+    std::uint64_t start_ns;
+    std::uint64_t duration_ns;
+};
+
+/**
+ * Ring buffer of the events of one thread. Only the owning thread writes to it.
+ */
+class ThreadBuffer {
+public:
+    ThreadBuffer(size_t capacity, size_t thread_index) : _events(capacity), _thread_index(thread_index) {}
+
+    void push(Event const& event) {
+        auto const& index = _num_written.load(std::memory_order_relaxed);
+        _events.at(index % _events.size()) = event;
+        _num_written.store(index + 1, std::memory_order_release);
+    }
+
+    void write_events(std::ostream& output, bool& first) const {
+        auto const& num_written = _num_written.load(std::memory_order_acquire);
+        auto const& first_index = num_written > _events.size() ? num_written - _events.size() : 0;
+        for (auto i = first_index; i < num_written; ++i) {
+            auto const& event = _events.at(i % _events.size());
+            output << (first ? "\n" : ",\n") << "{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, "
+                   << "\"tid\": " << _thread_index << ", \"ts\": " << static_cast<double>(event.start_ns) / 1e3
+                   << ", \"dur\": " << static_cast<double>(event.duration_ns) / 1e3;
+            if (event.arg_name) {
+                output << ", \"args\": {\"" << event.arg_name << "\": " << event.arg_value << "}";
+            }
+            output << "}";
+            first = false;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t num_dropped() const {
+        auto const& num_written = _num_written.load(std::memory_order_acquire);
+        return num_written > _events.size() ? num_written - _events.size() : 0;
+    }
+
+    /// Number of start_sample events seen by this thread
+    unsigned sample_counter = 0;
+    /// Whether the innermost start_sample event of this thread is recorded
+    bool in_sample = false;
+
+private:
+    std::vector<Event> _events;
+    /// Total number of events pushed, the next one is stored at index _num_written % capacity
+    std::atomic<std::uint64_t> _num_written{0};
+    size_t _thread_index;
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> tracing_enabled{false};
+std::atomic<size_t> buffer_capacity{1};
+std::atomic<unsigned> sample_interval{1};
+Clock::time_point trace_start;
+
+std::mutex registry_mutex;
+/// All buffers ever created, buffers of finished threads are kept for the export
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+ThreadBuffer& thread_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (not buffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry.push_back(std::make_unique<ThreadBuffer>(buffer_capacity.load(), registry.size()));
+        buffer = registry.back().get();
+    }
+    return *buffer;
+}
+
+std::uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - trace_start).count();
+}
+
+} // end of anonymous namespace
+
+void enable(size_t events_per_thread, unsigned sample_every) {
+    buffer_capacity = std::max<size_t>(events_per_thread, 1);
+    sample_interval = std::max(sample_every, 1u);
+    trace_start = Clock::now();
+    tracing_enabled = true;
+}
+
+bool enabled() {
+    return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void write_chrome_json(std::ostream& output) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    output << "{\"traceEvents\": [";
+    bool first = true;
+    std::uint64_t num_dropped = 0;
+    for (auto const& buffer : registry) {
+        buffer->write_events(output, first);
+        num_dropped += buffer->num_dropped();
+    }
+    output << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"sample_every\": " << sample_interval.load()
+           << ", \"dropped_events\": " << num_dropped << "}}\n";
+}
+
+Scope::Scope(char const* name, Sampling sampling) : _name(name) {
+    if (not enabled()) {
+        return;
+    }
+    _buffer = &thread_buffer();
+    switch (sampling) {
+        case Sampling::always:
+            _recording = true;
+            break;
+        case Sampling::start_sample:
+            _started_sample = true;
+            _previous_sampled = _buffer->in_sample;
+            _recording = _buffer->sample_counter++ % sample_interval.load(std::memory_order_relaxed) == 0;
+            _buffer->in_sample = _recording;
+            break;
+        case Sampling::if_sampled:
+            _recording = _buffer->in_sample;
+            break;
+    }
+    if (_recording) {
+        _start_ns = now_ns();
+    }
+}
+
+Scope::~Scope() {
+    if (_recording) {
+        _buffer->push({_name, _arg_name, _arg_value, _start_ns, now_ns() - _start_ns});
+    }
+    if (_started_sample) {
+        _buffer->in_sample = _previous_sampled;
+    }
+}
+
+void Scope::set_arg(char const* name, std::int64_t value) {
+    _arg_name = name;
+    _arg_value = value;
+}
+
+} // namespace trace
@@ -0,0 +1,76 @@
+#ifndef MAXMATCHING_TRACE_H
+#define MAXMATCHING_TRACE_H
+
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * Timeline tracing of solver phases, exported in the Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+ *
+ * Tracing is off until enable is called, a disabled Scope only costs one relaxed atomic load. Every thread appends
+ * its events to its own ring buffer without any locking, only the first event of a thread takes a lock to register
+ * the buffer. Once a buffer is full, the oldest events are overwritten.
+ *
+ * Fine grained events (single trees and the shrink/expand bursts within them) would be too expensive to record for
+ * every tree on large instances, so they are sampled: Only every n-th tree of a thread is recorded, together with all
+ * if_sampled events inside of it.
+ */
+namespace trace {
+
+class ThreadBuffer;
+
+enum class Sampling {
+    /// Always record this event
+    always,
+    /// Record this event and all if_sampled events within it for every n-th event of this kind
+    start_sample,
+    /// Record only if an enclosing start_sample event is recorded
+    if_sampled,
+};
+
+/**
+ * Start recording events. Call this before any other thread uses tracing.
+ * @param events_per_thread Ring buffer capacity of each thread
+ * @param sample_every Record every sample_every-th start_sample event, 1 to record all of them
+ */
+void enable(size_t events_per_thread, unsigned sample_every);
+
+[[nodiscard]] bool enabled();
+
+/**
+ * Writes all recorded events as Chrome trace JSON. Threads should not record events while this is running, events
+ * overwritten concurrently may appear corrupted otherwise.
+ */
+void write_chrome_json(std::ostream& output);
+
+/**
+ * Records a complete event from its construction to its destruction.
+ */
+class Scope {
+public:
+    /// @param name Needs to outlive the export, usually a string literal
+    explicit Scope(char const* name, Sampling sampling = Sampling::always);
+
+    ~Scope();
+
+    Scope(Scope const&) = delete;
+
+    Scope& operator=(Scope const&) = delete;
+
+    /// Attaches a numeric argument shown with the event, only one argument per event is stored
+    void set_arg(char const* name, std::int64_t value);
+
+private:
+    ThreadBuffer* _buffer = nullptr;
+    char const* _name;
+    char const* _arg_name = nullptr;
+    std::int64_t _arg_value = 0;
+    std::uint64_t _start_ns = 0;
+    bool _recording = false;
+    bool _started_sample = false;
+    bool _previous_sampled = false;
+};
+
+} // namespace trace
+
+#endif //MAXMATCHING_TRACE_H